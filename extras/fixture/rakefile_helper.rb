@@ -13,6 +13,12 @@ require HERE+'../../auto/colour_reporter'
 module RakefileHelpers
 
   C_EXTENSION = '.c'
+
+  # the fixture tests run against the optional features of the fixture, too
+  FIXTURE_DEFINES = ['UNITY_OUTPUT_CHAR=UnityOutputCharSpy_OutputChar', 'UNITY_DYNAMIC_MEM_DEBUG', 'UNITY_CPP_UNIT_COMPAT',
+                     'UNITY_PARALLEL', 'UNITY_GOLDEN_FILES', 'UNITY_PERF_COUNTERS',
+                     'UNITY_BENCHMARK']
+  FIXTURE_LIBRARIES = ['-lpthread']
   
   def load_configuration(config_file)
     unless ($configured)
@@ -54,7 +60,7 @@ module RakefileHelpers
     if $cfg['compiler']['defines']['items'].nil?
       defines  = ''
     else
-      defines  = squash($cfg['compiler']['defines']['prefix'], $cfg['compiler']['defines']['items'] + ['UNITY_OUTPUT_CHAR=UnityOutputCharSpy_OutputChar'])
+      defines  = squash($cfg['compiler']['defines']['prefix'], $cfg['compiler']['defines']['items'] + FIXTURE_DEFINES)
     end
     options  = squash('', $cfg['compiler']['options'])
     includes = squash($cfg['compiler']['includes']['prefix'], $cfg['compiler']['includes']['items'])
@@ -93,7 +99,8 @@ module RakefileHelpers
       (obj_list.map{|obj|"#{$cfg['linker']['object_files']['path']}#{obj} "}).join +
       $cfg['linker']['bin_files']['prefix'] + ' ' +
       $cfg['linker']['bin_files']['destination'] +
-      exe_name + $cfg['linker']['bin_files']['extension']
+      exe_name + $cfg['linker']['bin_files']['extension'] +
+      squash('', FIXTURE_LIBRARIES)
     execute(cmd_str)
   end
   
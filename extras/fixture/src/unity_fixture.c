@@ -5,13 +5,78 @@
     [Released under MIT License. Please refer to license.txt for details]
 ========================================== */
 
+/* DX_PATCH: a -std=c99 build does not declare what the benchmarks need from the system:
+   clock_gettime, CLOCK_MONOTONIC and struct timespec for the timer, CLOCK_THREAD_CPUTIME_ID for
+   the CPU time, gethostname and getloadavg for the context of --benchmark-out, and
+   sched_setaffinity with the CPU_SET macros for --pin-cpu. getloadavg and the CPU_SET macros are
+   GNU extensions, so this asks for _GNU_SOURCE rather than a POSIX level. */
+#if defined(UNITY_BENCHMARK) && !defined(_GNU_SOURCE)
+#define _GNU_SOURCE
+#endif
+/* DX_PATCH: syscall, which opens the --perf-counters */
+#if defined(UNITY_PERF_COUNTERS) && !defined(_DEFAULT_SOURCE)
+#define _DEFAULT_SOURCE
+#endif
+/* DX_PATCH: a -std=c99 build only declares the POSIX interfaces that are asked for: posix_memalign
+   and the condition variables of the parallel runner, and the file and mapping calls of the golden
+   files (fsync, posix_madvise) */
+#if (defined(UNITY_PARALLEL) || defined(UNITY_GOLDEN_FILES)) && !defined(_POSIX_C_SOURCE)
+#define _POSIX_C_SOURCE 200809L
+#endif
+
 #include <string.h>
 #include <assert.h>
 #include <stdlib.h>
+#if defined(UNITY_PARALLEL)
+#include <pthread.h>
+#endif
+#if defined(UNITY_GOLDEN_FILES) || defined(UNITY_DYNAMIC_MEM_DEBUG) || defined(UNITY_BENCHMARK)
+#include <stdio.h>
+#endif
+#if defined(UNITY_GOLDEN_FILES)
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+#if defined(UNITY_PERF_COUNTERS)
+#include <stdint.h>
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <linux/perf_event.h>
+#endif
+#if defined(UNITY_BENCHMARK)
+#include <stdint.h>
+#include <time.h>
+#include <unistd.h>
+#include <sched.h>
+#if defined(__x86_64__) || defined(__i386__)
+#include <cpuid.h>
+#endif
+#endif
 
 #include "unity_fixture.h"
 #include "unity_internals.h"
 
+/* DX_PATCH: the framework itself allocates from the system, never through the debug allocator */
+#ifdef malloc
+#undef malloc
+#endif
+
+#ifdef free
+#undef free
+#endif
+
+#ifdef calloc
+#undef calloc
+#endif
+
+#ifdef realloc
+#undef realloc
+#endif
+
 //If you decide to use the function pointer approach.
 /* DX_PATCH: As outputChar pointer approach is not used, and this generates a warning for
    MSVC - removed. */
@@ -30,7 +95,7 @@ static void announceTestRun(unsigned int runNumber, struct _Unity * const unity_
     UnityPrintNumber(runNumber+1, unity_p);
     UnityPrint(" of ", unity_p);
     UnityPrintNumber(unity_p->RepeatCount, unity_p);
-    UNITY_OUTPUT_CHAR('\n');
+    UNITY_PRINT_CHAR('\n', unity_p);
 }
 
 int UnityMain(int argc, char* argv[], void (*runAllTests)(struct _Unity * const unity_p), struct _Unity * const unity_p)
@@ -39,296 +104,3222 @@ int UnityMain(int argc, char* argv[], void (*runAllTests)(struct _Unity * const
     unsigned int r;
     if (result != 0)
         return result;
+#if defined(UNITY_BENCHMARK)
+    if (UnityBench_Begin(argc, argv, unity_p) != 0)
+        return 1;
+#endif
 
     for (r = 0; r < unity_p->RepeatCount; r++)
     {
         announceTestRun(r, unity_p);
         UnityBegin(unity_p);
+#if defined(UNITY_PARALLEL)
+        UnityParallel_Begin(unity_p);
         runAllTests(unity_p);
-        UNITY_OUTPUT_CHAR('\n');
+        UnityParallel_Run(unity_p);
+#else
+        runAllTests(unity_p);
+#endif
+        UNITY_PRINT_CHAR('\n', unity_p);
         UnityEnd(unity_p);
+#if defined(UNITY_PARALLEL)
+        UnityParallel_End(unity_p);
+#endif
+    }
+#if defined(UNITY_BENCHMARK)
+    UnityBench_End(unity_p);
+#endif
+
+    return UnityFailureCount(unity_p);
+}
+
+static int selected(const char * filter, const char * name)
+{
+    if (filter == 0)
+        return 1;
+    return strstr(name, filter) ? 1 : 0;
+}
+
+static int testSelected(const char* test, struct _Unity * const unity_p)
+{
+    return selected(unity_p->NameFilter, test);
+}
+
+static int groupSelected(const char* group, struct _Unity * const unity_p)
+{
+    return selected(unity_p->GroupFilter, group);
+}
+
+/* DX_PATCH: one setup/body/teardown pass of a test, shared by the normal and the repeat runner */
+static void runTestCase(unityfunction * setup,
+        unityTestfunction * body,
+        unityTestfunction * teardown,
+        struct _Unity * const unity_p)
+{
+    /* remember setup has failed - skip teardown if so*/
+    bool hasSetupFailed = false;
+
+#if defined(UNITY_DYNAMIC_MEM_DEBUG)
+    UnityMalloc_StartTest(unity_p);
+    if (unity_p->MallocFailIndex >= 0)
+        UnityMalloc_FailAllocation(unity_p->MallocFailIndex, unity_p);
+#endif
+#if defined(UNITY_CPP_UNIT_COMPAT)
+    UnityPointer_Init(unity_p);
+#endif
+    if (TEST_PROTECT())
+    {
+        setup(unity_p);
+        /*DX_PATCH for jumpless version. If setup failed don't perform the test*/
+        if (!unity_p->CurrentTestFailed)
+        {
+#if defined(UNITY_PERF_COUNTERS)
+            UnityPerf_Start(&unity_p->Perf);
+#endif
+            body(unity_p->testLocalStorage, unity_p);
+#if defined(UNITY_PERF_COUNTERS)
+            UnityPerf_Stop(&unity_p->Perf);
+#endif
+        }
+        else
+        {
+            hasSetupFailed  = true;
+        }
+    }
+    if (TEST_PROTECT() && !hasSetupFailed )
+    {
+        teardown(unity_p->testLocalStorage, unity_p);
+    }
+    if (TEST_PROTECT())
+    {
+#if defined(UNITY_CPP_UNIT_COMPAT)
+        UnityPointer_UndoAllSets(unity_p);
+#endif
+#if defined(UNITY_DYNAMIC_MEM_DEBUG)
+        UnityMalloc_EndTest(unity_p);
+#endif
+    }
+}
+
+//-------------------------------------------------
+//libm-free math
+/* DX_PATCH: the statistics of the runner use these few functions instead of <math.h>, so that
+   the fixture still links without libm, as Unity itself does. */
+
+// Newton iteration
+static double squareRoot(double x)
+{
+    double root = x;
+    int i;
+
+    if (x <= 0.0)
+        return 0.0;
+    if (root < 1.0)
+        root = 1.0;
+    for (i = 0; i < 64; i++)
+        root = 0.5 * (root + x / root);
+    return root;
+}
+
+#if defined(UNITY_BENCHMARK)
+// Natural logarithm, for the complexity fit and the compared ratios of the benchmarks
+static double logarithm(double x)
+{
+    double exponent = 0.0;
+    double y, square, term, sum = 0.0;
+    int k;
+
+    while (x >= 2.0)
+    {
+        x *= 0.5;
+        exponent += 1.0;
+    }
+    while (x < 1.0)
+    {
+        x *= 2.0;
+        exponent -= 1.0;
+    }
+    // ln x = 2 atanh((x - 1) / (x + 1)), which converges quickly for x in [1, 2)
+    y = (x - 1.0) / (x + 1.0);
+    square = y * y;
+    term = y;
+    for (k = 1; k < 40; k += 2)
+    {
+        sum += term / (double)k;
+        term *= square;
+    }
+    return 2.0 * sum + exponent * 0.69314718055994530942;
+}
+
+// e^x, for the confidence interval of a compared benchmark
+static double exponential(double x)
+{
+    double power = 1.0, term = 1.0, sum = 1.0;
+    int halvings = 0;
+    int k;
+
+    // e^x = (e^(x / 2^h))^(2^h), with x / 2^h small enough for a short series
+    while ((x > 0.5) || (x < -0.5))
+    {
+        x *= 0.5;
+        halvings++;
+    }
+    for (k = 1; k < 20; k++)
+    {
+        term *= x / (double)k;
+        sum += term;
+    }
+    power = sum;
+    while (halvings-- > 0)
+        power *= power;
+    return power;
+}
+#endif
+
+//-------------------------------------------------
+//Repeated tests
+static void printPercent(double fraction, struct _Unity * const unity_p)
+{
+    unsigned long thousandths = (unsigned long)(fraction * 100000.0 + 0.5);
+
+    UnityPrintNumberUnsigned(thousandths / 1000, unity_p);
+    UNITY_PRINT_CHAR('.', unity_p);
+    UNITY_PRINT_CHAR((char)('0' + (thousandths / 100) % 10), unity_p);
+    UNITY_PRINT_CHAR((char)('0' + (thousandths / 10) % 10), unity_p);
+    UNITY_PRINT_CHAR((char)('0' + thousandths % 10), unity_p);
+    UNITY_PRINT_CHAR('%', unity_p);
+}
+
+/* DX_PATCH: New feature - --repeat-test / --until-fail. The test is looped without any per-run
+   output; only the first failure is printed, followed by the failure rate and its 95% Wilson
+   score interval. The whole loop is counted as a single test. */
+static void repeatTestCase(unityfunction * setup,
+        unityTestfunction * body,
+        unityTestfunction * teardown,
+        struct _Unity * const unity_p)
+{
+    const double z = 1.96;
+    unsigned long runs = 0;
+    unsigned long failures = 0;
+    double rate, denominator, center, halfWidth;
+    int ignored = 0;
+
+    UnityPrint(unity_p->CurrentTestName, unity_p);
+    UNITY_PRINT_CHAR('\n', unity_p);
+
+    while ((unity_p->RepeatTestCount == 0) || (runs < unity_p->RepeatTestCount))
+    {
+        runTestCase(setup, body, teardown, unity_p);
+        runs++;
+        ignored = unity_p->CurrentTestIgnored;
+        if (unity_p->CurrentTestFailed)
+        {
+            failures++;
+            unity_p->OutputMuted = 1;
+        }
+        unity_p->CurrentTestFailed = 0;
+        unity_p->CurrentTestIgnored = 0;
+        if (ignored || (unity_p->UntilFail && (failures > 0)))
+            break;
+    }
+    unity_p->OutputMuted = 0;
+
+    rate = (double)failures / (double)runs;
+    denominator = 1.0 + z * z / runs;
+    center = (rate + z * z / (2.0 * runs)) / denominator;
+    halfWidth = z * squareRoot(rate * (1.0 - rate) / runs + z * z / (4.0 * runs * runs)) / denominator;
+
+    UnityPrintNumberUnsigned(runs, unity_p);
+    UnityPrint(" runs, ", unity_p);
+    UnityPrintNumberUnsigned(failures, unity_p);
+    UnityPrint(" failures, failure rate ", unity_p);
+    printPercent(rate, unity_p);
+    UnityPrint(" (95% CI ", unity_p);
+    printPercent((center > halfWidth) ? (center - halfWidth) : 0.0, unity_p);
+    UnityPrint(" - ", unity_p);
+    printPercent((center + halfWidth < 1.0) ? (center + halfWidth) : 1.0, unity_p);
+    UNITY_PRINT_CHAR(')', unity_p);
+    // in verbose mode a passing test is completed with " PASS" by UnityConcludeFixtureTest
+    if (!unity_p->Verbose || (failures > 0) || ignored)
+        UNITY_PRINT_CHAR('\n', unity_p);
+
+    unity_p->CurrentTestIgnored = ignored;
+    unity_p->CurrentTestFailed = (failures > 0);
+}
+
+#if defined(UNITY_DYNAMIC_MEM_DEBUG)
+/* DX_PATCH: New feature - --alloc-sweep. A passing test is rerun once for every allocation
+   it made, with just that allocation failing. An assert failing in such a run is the expected
+   outcome of the injected fault, but the run must not leak, so the test data has to be
+   released in the teardown. The first leaking allocation is reported.
+   With -j N a sweep is opened to the workers: a worker that finds the test queue drained takes
+   ranges of UNITY_ALLOC_SWEEP_RANGE reruns into its own context. Like -j itself, this runs test
+   code concurrently, here the same test, so a test must not share writable globals. */
+#ifndef UNITY_ALLOC_SWEEP_RANGE
+#define UNITY_ALLOC_SWEEP_RANGE 8
+#endif
+
+typedef struct _UnitySweep
+{
+    unityfunction * setup;
+    unityTestfunction * body;
+    unityTestfunction * teardown;
+    const char * file;
+    const char * name;
+    UNITY_LINE_TYPE line;
+    unsigned long count;
+    unsigned long next;
+    unsigned long firstLeak;
+    unsigned long leaks;
+    unsigned int helpers;
+    struct _UnitySweep * nextOpen;
+} UnitySweep;
+
+static void sweepRuns(UnitySweep * sweep, struct _Unity * const unity_p)
+{
+    unsigned long index;
+    unsigned long last;
+
+    while ((index = __atomic_fetch_add(&sweep->next, UNITY_ALLOC_SWEEP_RANGE, __ATOMIC_RELAXED)) < sweep->count)
+    {
+        last = (sweep->count - index < UNITY_ALLOC_SWEEP_RANGE) ? sweep->count : index + UNITY_ALLOC_SWEEP_RANGE;
+        for (; index < last; index++)
+        {
+            unity_p->MallocFailIndex = (long)index;
+            runTestCase(sweep->setup, sweep->body, sweep->teardown, unity_p);
+            if (UnityMalloc_LiveBlocks(unity_p) != 0)
+            {
+                unsigned long first = __atomic_load_n(&sweep->firstLeak, __ATOMIC_RELAXED);
+
+                __atomic_fetch_add(&sweep->leaks, 1, __ATOMIC_RELAXED);
+                while ((index < first) &&
+                       !__atomic_compare_exchange_n(&sweep->firstLeak, &first, index, true,
+                                                    __ATOMIC_RELAXED, __ATOMIC_RELAXED))
+                    ;
+            }
+            unity_p->CurrentTestFailed = 0;
+            unity_p->CurrentTestIgnored = 0;
+        }
+    }
+    unity_p->MallocFailIndex = -1;
+}
+
+#if defined(UNITY_PARALLEL)
+static pthread_mutex_t sweepLock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t sweepChanged = PTHREAD_COND_INITIALIZER;
+static UnitySweep * openSweeps;
+static unsigned int sweepBusyWorkers;   // workers that may still open a sweep
+
+static void openSweep(UnitySweep * sweep)
+{
+    pthread_mutex_lock(&sweepLock);
+    sweep->nextOpen = openSweeps;
+    openSweeps = sweep;
+    pthread_cond_broadcast(&sweepChanged);
+    pthread_mutex_unlock(&sweepLock);
+}
+
+static void closeSweep(UnitySweep * sweep)
+{
+    UnitySweep ** link;
+
+    pthread_mutex_lock(&sweepLock);
+    for (link = &openSweeps; *link != sweep; link = &(*link)->nextOpen)
+        ;
+    *link = sweep->nextOpen;
+    // the results are complete once the last helper has left
+    while (sweep->helpers > 0)
+        pthread_cond_wait(&sweepChanged, &sweepLock);
+    pthread_mutex_unlock(&sweepLock);
+}
+
+static void sweepWorkerStarted(void)
+{
+    pthread_mutex_lock(&sweepLock);
+    sweepBusyWorkers++;
+    pthread_mutex_unlock(&sweepLock);
+}
+
+/* A worker whose test queue is drained helps the open sweeps until no busy worker is left
+   that could open another one. */
+static void helpSweeps(struct _Unity * const unity_p)
+{
+    int muted = unity_p->OutputMuted;
+
+    pthread_mutex_lock(&sweepLock);
+    sweepBusyWorkers--;
+    pthread_cond_broadcast(&sweepChanged);
+    for (;;)
+    {
+        UnitySweep * sweep = openSweeps;
+
+        while ((sweep != NULL) && (__atomic_load_n(&sweep->next, __ATOMIC_RELAXED) >= sweep->count))
+            sweep = sweep->nextOpen;
+        if (sweep == NULL)
+        {
+            if (sweepBusyWorkers == 0)
+                break;
+            pthread_cond_wait(&sweepChanged, &sweepLock);
+            continue;
+        }
+        sweep->helpers++;
+        pthread_mutex_unlock(&sweepLock);
+
+        unity_p->TestFile = sweep->file;
+        unity_p->CurrentTestName = sweep->name;
+        unity_p->CurrentTestLineNumber = sweep->line;
+        unity_p->OutputMuted = 1;
+        sweepRuns(sweep, unity_p);
+        unity_p->OutputMuted = muted;
+
+        pthread_mutex_lock(&sweepLock);
+        if (--sweep->helpers == 0)
+            pthread_cond_broadcast(&sweepChanged);
+    }
+    pthread_mutex_unlock(&sweepLock);
+}
+#endif
+
+static void sweepTestCase(unityfunction * setup,
+        unityTestfunction * body,
+        unityTestfunction * teardown,
+        struct _Unity * const unity_p)
+{
+    UnitySweep sweep;
+    UnityAllocationStats stats;
+    const char * file = unity_p->TestFile;
+    int muted = unity_p->OutputMuted;
+    char message[96];
+
+    runTestCase(setup, body, teardown, unity_p);
+    if (unity_p->CurrentTestFailed || unity_p->CurrentTestIgnored)
+        return;
+
+    stats = *UnityMalloc_Stats(unity_p);
+    memset(&sweep, 0, sizeof(sweep));
+    sweep.setup = setup;
+    sweep.body = body;
+    sweep.teardown = teardown;
+    sweep.file = file;
+    sweep.name = unity_p->CurrentTestName;
+    sweep.line = unity_p->CurrentTestLineNumber;
+    sweep.count = (unsigned long)unity_p->Malloc.Attempts;
+    sweep.firstLeak = sweep.count;
+
+#if defined(UNITY_PARALLEL)
+    if ((unity_p->Jobs > 1) && (sweep.count > UNITY_ALLOC_SWEEP_RANGE))
+        openSweep(&sweep);
+#endif
+    unity_p->OutputMuted = 1;
+    sweepRuns(&sweep, unity_p);
+    unity_p->OutputMuted = muted;
+#if defined(UNITY_PARALLEL)
+    if ((unity_p->Jobs > 1) && (sweep.count > UNITY_ALLOC_SWEEP_RANGE))
+        closeSweep(&sweep);
+#endif
+    unity_p->TestFile = file;
+    UnityMalloc_RestoreStats(&stats, unity_p);
+
+    if (sweep.leaks > 0)
+    {
+        snprintf(message, sizeof(message), "Leaks when allocation %lu of %lu fails (%lu leaking runs)",
+                 sweep.firstLeak + 1, sweep.count, sweep.leaks);
+        UnityFail(message, unity_p->CurrentTestLineNumber, file, true, unity_p);
+    }
+}
+#endif
+
+static void runSelectedTest(unityfunction * setup,
+        unityTestfunction * body,
+        unityTestfunction * teardown,
+        const char * printableName,
+        const char * file, int line, struct _Unity * const unity_p)
+{
+    unity_p->CurrentTestFailed = 0;
+    unity_p->TestFile = file;
+    unity_p->CurrentTestName = printableName;
+    unity_p->CurrentTestLineNumber = line;
+    unity_p->NumberOfTests++;
+
+    if ((unity_p->RepeatTestCount > 0) || unity_p->UntilFail)
+    {
+        repeatTestCase(setup, body, teardown, unity_p);
+    }
+#if defined(UNITY_DYNAMIC_MEM_DEBUG)
+    else if (unity_p->AllocSweep)
+    {
+        if (!unity_p->Verbose)
+            UNITY_PRINT_CHAR('.', unity_p);
+        else
+            UnityPrint(printableName, unity_p);
+        sweepTestCase(setup, body, teardown, unity_p);
+    }
+#endif
+    else
+    {
+        if (!unity_p->Verbose)
+            UNITY_PRINT_CHAR('.', unity_p);
+        else
+            UnityPrint(printableName, unity_p);
+        runTestCase(setup, body, teardown, unity_p);
+#if defined(UNITY_BENCHMARK) && defined(UNITY_PERF_COUNTERS)
+        if (!unity_p->CurrentTestIgnored)
+            UnityBench_WriteTestCounters(unity_p);
+#endif
+    }
+    UnityConcludeFixtureTest(unity_p);
+}
+
+#if defined(UNITY_PARALLEL)
+//-------------------------------------------------
+//Parallel runner
+//
+/* DX_PATCH: New feature - -j N. While runAllTests walks the test groups, the selected tests are
+   only collected. They are then run by N workers, each with its own copy of the context, so the
+   per-test state never needs a lock. Every worker publishes its counters into its own cache line
+   aligned result slot, and UnityEnd reduces the slots into the main context.
+   The output of each test is captured into its own buffer. Finished buffers are pushed onto a
+   lock-free list, and a single writer thread prints them in completion order, or in declaration
+   order with --ordered-output, so the output of a test is never interleaved with another one.
+   The writer sleeps on a condition variable while the list is empty. */
+typedef struct _UnityTestJob
+{
+    unityfunction * setup;
+    unityTestfunction * body;
+    unityTestfunction * teardown;
+    const char * printableName;
+    const char * file;
+    int line;
+} UnityTestJob;
+
+typedef struct _UnityWorker
+{
+    struct _Unity context;
+    struct _UnityResultSlot * slot;
+    struct _UnityParallel * run;
+    pthread_t thread;
+} UnityWorker;
+
+struct _UnityParallel
+{
+    UnityTestJob * jobs;
+    unsigned int jobCount;
+    unsigned int jobCapacity;
+    unsigned int nextJob;
+    struct _UnityResultSlot * slots;
+    unsigned int workerCount;
+    struct _UnityOutputBuffer * outputs;
+    struct _UnityOutputBuffer * completed;
+    unsigned char * finished;
+    int ordered;
+    pthread_mutex_t lock;           // only guards the sleep of the writer, not the list
+    pthread_cond_t wake;
+};
+
+void UnityParallel_Begin(struct _Unity * const unity_p)
+{
+    struct _UnityParallel * run;
+
+    if (unity_p->Jobs <= 1)
+        return;
+    run = (struct _UnityParallel *)UNITY_INTERNAL_CALLOC(1, sizeof(*run));
+    unity_p->Parallel = run;
+}
+
+static int enqueueTest(unityfunction * setup,
+        unityTestfunction * body,
+        unityTestfunction * teardown,
+        const char * printableName,
+        const char * file, int line, struct _Unity * const unity_p)
+{
+    struct _UnityParallel * run = unity_p->Parallel;
+    UnityTestJob * job;
+
+    if (run->jobCount == run->jobCapacity)
+    {
+        unsigned int capacity = (run->jobCapacity == 0) ? 64 : run->jobCapacity * 2;
+        UnityTestJob * jobs = (UnityTestJob *)UNITY_INTERNAL_REALLOC(run->jobs, capacity * sizeof(*jobs));
+        if (jobs == NULL)
+            return 0;
+        run->jobs = jobs;
+        run->jobCapacity = capacity;
     }
 
-    return UnityFailureCount(unity_p);
+    job = &run->jobs[run->jobCount++];
+    job->setup = setup;
+    job->body = body;
+    job->teardown = teardown;
+    job->printableName = printableName;
+    job->file = file;
+    job->line = line;
+    return 1;
+}
+
+static void publishResults(UnityWorker * worker)
+{
+    // single writer per slot; relaxed is enough for progress readers, and UnityEnd runs after the join
+    __atomic_store_n(&worker->slot->NumberOfTests, worker->context.NumberOfTests, __ATOMIC_RELAXED);
+    __atomic_store_n(&worker->slot->TestFailures, worker->context.TestFailures, __ATOMIC_RELAXED);
+    __atomic_store_n(&worker->slot->TestIgnores, worker->context.TestIgnores, __ATOMIC_RELAXED);
+}
+
+static void pushCompleted(struct _UnityParallel * run, struct _UnityOutputBuffer * buffer)
+{
+    struct _UnityOutputBuffer * head = __atomic_load_n(&run->completed, __ATOMIC_RELAXED);
+
+    do
+    {
+        buffer->Next = head;
+    } while (!__atomic_compare_exchange_n(&run->completed, &head, buffer, true,
+                                          __ATOMIC_RELEASE, __ATOMIC_RELAXED));
+
+    // the writer checks the list under the lock before it sleeps, so this wakeup cannot be missed
+    pthread_mutex_lock(&run->lock);
+    pthread_cond_signal(&run->wake);
+    pthread_mutex_unlock(&run->lock);
+}
+
+static void writeBuffer(struct _UnityOutputBuffer * buffer)
+{
+    unsigned long i;
+
+    for (i = 0; i < buffer->Length; i++)
+        UNITY_OUTPUT_CHAR(buffer->Data[i]);
+    UNITY_INTERNAL_FREE(buffer->Data);
+    buffer->Data = NULL;
+}
+
+static void * outputWriter(void * arg)
+{
+    struct _UnityParallel * run = (struct _UnityParallel *)arg;
+    unsigned int written = 0;
+    unsigned int nextInOrder = 0;
+
+    while (written < run->jobCount)
+    {
+        struct _UnityOutputBuffer * done = __atomic_exchange_n(&run->completed, NULL, __ATOMIC_ACQUIRE);
+        struct _UnityOutputBuffer * inOrder = NULL;
+        struct _UnityOutputBuffer * next;
+
+        if (done == NULL)
+        {
+            pthread_mutex_lock(&run->lock);
+            while (__atomic_load_n(&run->completed, __ATOMIC_RELAXED) == NULL)
+                pthread_cond_wait(&run->wake, &run->lock);
+            pthread_mutex_unlock(&run->lock);
+            continue;
+        }
+
+        // the list holds the most recently finished test first
+        for (; done != NULL; done = next)
+        {
+            next = done->Next;
+            done->Next = inOrder;
+            inOrder = done;
+        }
+
+        for (; inOrder != NULL; inOrder = next)
+        {
+            next = inOrder->Next;
+            if (!run->ordered)
+            {
+                writeBuffer(inOrder);
+                written++;
+            }
+            else
+            {
+                run->finished[inOrder - run->outputs] = 1;
+            }
+        }
+
+        while ((nextInOrder < run->jobCount) && run->finished[nextInOrder])
+        {
+            writeBuffer(&run->outputs[nextInOrder++]);
+            written++;
+        }
+    }
+    return NULL;
+}
+
+static void * parallelWorker(void * arg)
+{
+    UnityWorker * worker = (UnityWorker *)arg;
+    struct _UnityParallel * run = worker->run;
+    unsigned int index;
+
+#if defined(UNITY_DYNAMIC_MEM_DEBUG)
+    sweepWorkerStarted();
+#endif
+    for (;;)
+    {
+        const UnityTestJob * job;
+
+        index = __atomic_fetch_add(&run->nextJob, 1, __ATOMIC_RELAXED);
+        if (index >= run->jobCount)
+            break;
+        job = &run->jobs[index];
+        if (run->outputs != NULL)
+            worker->context.Capture = &run->outputs[index];
+        runSelectedTest(job->setup, job->body, job->teardown,
+                job->printableName, job->file, job->line, &worker->context);
+        publishResults(worker);
+        if (run->outputs != NULL)
+        {
+            worker->context.Capture = NULL;
+            pushCompleted(run, &run->outputs[index]);
+        }
+    }
+#if defined(UNITY_DYNAMIC_MEM_DEBUG)
+    helpSweeps(&worker->context);
+#endif
+    return NULL;
+}
+
+void UnityParallel_Run(struct _Unity * const unity_p)
+{
+    struct _UnityParallel * run = unity_p->Parallel;
+    UnityWorker ** workers;
+    unsigned int count;
+    unsigned int i;
+    unsigned int started = 0;
+    pthread_t writer;
+    int writerStarted = 0;
+    void * memory;
+
+    if (run == NULL)
+        return;
+    unity_p->Parallel = NULL;
+
+    run->ordered = unity_p->OrderedOutput;
+    run->outputs = (struct _UnityOutputBuffer *)UNITY_INTERNAL_CALLOC(run->jobCount ? run->jobCount : 1, sizeof(*run->outputs));
+    run->finished = (unsigned char *)UNITY_INTERNAL_CALLOC(run->jobCount ? run->jobCount : 1, 1);
+    if ((run->outputs == NULL) || (run->finished == NULL))
+    {
+        // without capture buffers the tests still run, only their output may interleave
+        UNITY_INTERNAL_FREE(run->outputs);
+        run->outputs = NULL;
+    }
+    pthread_mutex_init(&run->lock, NULL);
+    pthread_cond_init(&run->wake, NULL);
+
+    count = (unity_p->Jobs < run->jobCount) ? unity_p->Jobs : run->jobCount;
+    workers = (UnityWorker **)UNITY_INTERNAL_CALLOC(count ? count : 1, sizeof(*workers));
+    if ((workers != NULL) && (count > 0) &&
+        (posix_memalign(&memory, UNITY_CACHE_LINE_SIZE, count * sizeof(struct _UnityResultSlot)) == 0))
+    {
+        run->slots = (struct _UnityResultSlot *)memory;
+        memset(run->slots, 0, count * sizeof(struct _UnityResultSlot));
+        unity_p->ResultSlots = run->slots;
+        unity_p->ResultSlotCount = count;
+        for (i = 0; i < count; i++)
+        {
+            // each worker context on its own cache lines, too
+            if (posix_memalign(&memory, UNITY_CACHE_LINE_SIZE, sizeof(UnityWorker)) != 0)
+                break;
+            workers[i] = (UnityWorker *)memory;
+            workers[i]->context = *unity_p;
+            UnityBegin(&workers[i]->context);
+            workers[i]->slot = &run->slots[i];
+            workers[i]->run = run;
+            if (pthread_create(&workers[i]->thread, NULL, parallelWorker, workers[i]) != 0)
+            {
+                UNITY_INTERNAL_FREE(workers[i]);
+                workers[i] = NULL;
+                break;
+            }
+            started++;
+        }
+    }
+
+    if ((started > 0) && (run->outputs != NULL))
+        writerStarted = (pthread_create(&writer, NULL, outputWriter, run) == 0);
+
+    // whatever could not be handed to a worker runs here
+    if (started == 0)
+    {
+        while (run->nextJob < run->jobCount)
+        {
+            const UnityTestJob * job = &run->jobs[run->nextJob++];
+            runSelectedTest(job->setup, job->body, job->teardown,
+                    job->printableName, job->file, job->line, unity_p);
+        }
+    }
+
+    for (i = 0; i < started; i++)
+    {
+        pthread_join(workers[i]->thread, NULL);
+        UNITY_INTERNAL_FREE(workers[i]);
+    }
+    UNITY_INTERNAL_FREE(workers);
+
+    if (writerStarted)
+        pthread_join(writer, NULL);
+    else if ((started > 0) && (run->outputs != NULL))
+        outputWriter(run);
+    pthread_cond_destroy(&run->wake);
+    pthread_mutex_destroy(&run->lock);
+
+    run->workerCount = started;
+    unity_p->Parallel = run;
+}
+
+void UnityParallel_End(struct _Unity * const unity_p)
+{
+    struct _UnityParallel * run = unity_p->Parallel;
+
+    if (run == NULL)
+        return;
+    UNITY_INTERNAL_FREE(run->jobs);
+    UNITY_INTERNAL_FREE(run->slots);
+    UNITY_INTERNAL_FREE(run->outputs);
+    UNITY_INTERNAL_FREE(run->finished);
+    UNITY_INTERNAL_FREE(run);
+    unity_p->Parallel = NULL;
+}
+
+/* DX_PATCH: live totals of a parallel run, safe to call from another thread while the workers
+   are running. Tests counted by the main context itself are not included. */
+void UnityParallel_Progress(const struct _Unity * const unity_p,
+        UNITY_COUNTER_TYPE * tests, UNITY_COUNTER_TYPE * failures, UNITY_COUNTER_TYPE * ignores)
+{
+    const struct _UnityResultSlot * slots = unity_p->ResultSlots;
+    unsigned int count = unity_p->ResultSlotCount;
+    unsigned int i;
+
+    *tests = 0;
+    *failures = 0;
+    *ignores = 0;
+    for (i = 0; i < count; i++)
+    {
+        *tests += __atomic_load_n(&slots[i].NumberOfTests, __ATOMIC_RELAXED);
+        *failures += __atomic_load_n(&slots[i].TestFailures, __ATOMIC_RELAXED);
+        *ignores += __atomic_load_n(&slots[i].TestIgnores, __ATOMIC_RELAXED);
+    }
+}
+#endif /* UNITY_PARALLEL */
+
+void UnityTestRunner(unityfunction * setup,
+        unityTestfunction * body,
+        unityTestfunction * teardown,
+        const char * printableName,
+        const char * group,
+        const char * name,
+        const char * file, int line, struct _Unity * const unity_p)
+{
+    if (testSelected(name, unity_p) && groupSelected(group, unity_p))
+    {
+#if defined(UNITY_PARALLEL)
+        if ((unity_p->Parallel != NULL) &&
+            enqueueTest(setup, body, teardown, printableName, file, line, unity_p))
+            return;
+#endif
+        runSelectedTest(setup, body, teardown, printableName, file, line, unity_p);
+    }
+}
+
+void UnityIgnoreTest(const char * printableName, struct _Unity * const unity_p)
+{
+    unity_p->NumberOfTests++;
+    unity_p->CurrentTestIgnored = 1;
+    if (!unity_p->Verbose)
+        UNITY_PRINT_CHAR('!', unity_p);
+    else
+        UnityPrint(printableName, unity_p);
+    UnityConcludeFixtureTest(unity_p);
+}
+
+#if defined(UNITY_DYNAMIC_MEM_DEBUG)
+//-------------------------------------------------
+//Malloc and free stuff
+//
+#define MALLOC_DONT_FAIL -1
+/* DX_PATCH: the allocator state is kept in the context of the running test, which each thread
+   finds through its own current context pointer. Allocations made while no test is running on
+   the thread, e.g. by threads a test started, are not tracked; a block is only counted back
+   when it is released by the same test that allocated it, so blocks that outlive their test
+   never disturb the counters of a later one. */
+static UNITY_THREAD_LOCAL struct _Unity * malloc_context;
+static unsigned int malloc_test_ids;
+
+void UnityMalloc_StartTest(struct _Unity * const unity_p)
+{
+    struct _UnityMallocState * state = &unity_p->Malloc;
+
+    memset(state, 0, sizeof(*state));
+    state->FailCountdown = MALLOC_DONT_FAIL;
+    state->FailIndex = MALLOC_DONT_FAIL;
+    // zero is left for the blocks that belong to no test
+    do
+    {
+        state->TestId = __atomic_add_fetch(&malloc_test_ids, 1, __ATOMIC_RELAXED);
+    } while (state->TestId == 0);
+    malloc_context = unity_p;
+}
+
+// the blocks kept for reuse go back to the system when the test ends
+static void releasePool(struct _Unity * const unity_p)
+{
+    unsigned int i;
+
+    for (i = 0; i < UNITY_MALLOC_CLASSES; i++)
+    {
+        while (unity_p->Malloc.FreeLists[i] != NULL)
+        {
+            void * block = unity_p->Malloc.FreeLists[i];
+            unity_p->Malloc.FreeLists[i] = *(void **)block;
+            UNITY_INTERNAL_FREE(block);
+        }
+        unity_p->Malloc.FreeCounts[i] = 0;
+    }
+}
+
+void UnityMalloc_EndTest( struct _Unity * const unity_p )
+{
+    malloc_context = NULL;
+    releasePool(unity_p);
+    if (!unity_p->CurrentTestFailed && (unity_p->Malloc.Count != 0))
+    {
+        TEST_FAIL_MESSAGE("This test leaks!");
+    }
+}
+
+static struct _UnityMallocState * currentState(void)
+{
+    return (malloc_context != NULL) ? &malloc_context->Malloc : NULL;
+}
+
+void UnityMalloc_MakeMallocFailAfterCount(int countdown)
+{
+    struct _UnityMallocState * state = currentState();
+
+    if (state != NULL)
+        state->FailCountdown = countdown;
+}
+
+void UnityMalloc_FailAllocation(long index, struct _Unity * const unity_p)
+{
+    unity_p->Malloc.FailIndex = index;
+}
+
+/* DX_PATCH: New feature - failure injection. Besides the countdown, a single allocation can be
+   failed by its index (used by --alloc-sweep), every allocation of one call site, or a seeded
+   random share of the allocations, so that a failing run can be reproduced.
+   The file matches when it ends with the given name, so "parser.c" selects "src/parser.c".
+   Only the malloc macros pass a call site; the linker wrappers cannot, so a site is refused
+   in a UNITY_WRAP_MALLOC build instead of never matching. */
+void UnityMalloc_MakeMallocFailAtSite(const char * file, int line)
+{
+    struct _UnityMallocState * state = currentState();
+
+    if (state == NULL)
+        return;
+#if defined(UNITY_WRAP_MALLOC)
+    (void)file;
+    (void)line;
+    UnityFail("Allocation sites need the malloc macros, they are unknown with UNITY_WRAP_MALLOC",
+              (UNITY_LINE_TYPE)__LINE__, __FILE__, true, malloc_context);
+#else
+    state->FailFile = file;
+    state->FailLine = line;
+#endif
+}
+
+void UnityMalloc_MakeMallocFailWithProbability(double probability, unsigned int seed)
+{
+    struct _UnityMallocState * state = currentState();
+
+    if (state == NULL)
+        return;
+    if (probability <= 0.0)
+        state->FailThreshold = 0;
+    else if (probability >= 1.0)
+        state->FailThreshold = 0xFFFFFFFFu;
+    else
+        state->FailThreshold = (_UU32)(probability * 4294967296.0);
+    state->Random = (_UU32)seed ^ 0x9E3779B9u;
+    if (state->Random == 0)
+        state->Random = 1;
+}
+
+static int siteMatches(const struct _UnityMallocState * state, const char * file, int line)
+{
+    size_t length;
+    size_t wanted;
+
+    if ((line != state->FailLine) || (file == NULL) || (state->FailFile == NULL))
+        return 0;
+    length = strlen(file);
+    wanted = strlen(state->FailFile);
+    return (length >= wanted) && (strcmp(file + length - wanted, state->FailFile) == 0);
+}
+
+static int injectFailure(struct _UnityMallocState * state, const char * file, int line)
+{
+    long attempt = state->Attempts++;
+
+    if (state->FailCountdown != MALLOC_DONT_FAIL)
+    {
+        if (state->FailCountdown == 0)
+            return 1;
+        state->FailCountdown--;
+    }
+    if (attempt == state->FailIndex)
+        return 1;
+    if ((state->FailLine != 0) && siteMatches(state, file, line))
+        return 1;
+    if (state->FailThreshold != 0)
+    {
+        // xorshift32, cheap and the same sequence for the same seed on every platform
+        state->Random ^= state->Random << 13;
+        state->Random ^= state->Random >> 17;
+        state->Random ^= state->Random << 5;
+        return (state->Random <= state->FailThreshold);
+    }
+    return 0;
+}
+
+int UnityMalloc_LiveBlocks(const struct _Unity * const unity_p)
+{
+    return unity_p->Malloc.Count;
+}
+
+const UnityAllocationStats * UnityMalloc_Stats(const struct _Unity * const unity_p)
+{
+    return &unity_p->Malloc.Stats;
+}
+
+void UnityMalloc_RestoreStats(const UnityAllocationStats * stats, struct _Unity * const unity_p)
+{
+    unity_p->Malloc.Stats = *stats;
+}
+
+void UnityMalloc_PrintStats(struct _Unity * const unity_p)
+{
+    const UnityAllocationStats * stats = &unity_p->Malloc.Stats;
+
+    UnityPrint(" (", unity_p);
+    UnityPrintNumberUnsigned(stats->Allocations, unity_p);
+    UnityPrint(" allocations, ", unity_p);
+    UnityPrintNumberUnsigned(stats->Bytes, unity_p);
+    UnityPrint(" bytes, peak ", unity_p);
+    UnityPrintNumberUnsigned(stats->PeakBytes, unity_p);
+    UnityPrint(" bytes, ", unity_p);
+    UnityPrintNumberUnsigned(stats->Reallocs, unity_p);
+    UnityPrint(" reallocs)", unity_p);
+}
+
+static bool allocationBudgetFail(const char * what, unsigned long limit, unsigned long actual, const char * msg,
+                                 const UNITY_LINE_TYPE line, const char * file, struct _Unity * const unity_p)
+{
+    char message[160];
+
+    snprintf(message, sizeof(message), "Expected at most %lu %s Was %lu%s%s", limit, what, actual,
+             (msg != NULL) ? ". " : "", (msg != NULL) ? msg : "");
+    return UnityFail(message, line, file, true, unity_p);
+}
+
+bool UnityMalloc_AssertMaxAllocations(unsigned long limit, const char * msg,
+                                      const UNITY_LINE_TYPE line, const char * file, struct _Unity * const unity_p)
+{
+    if (unity_p->CurrentTestFailed || unity_p->CurrentTestIgnored)
+        return true;
+    if (unity_p->Malloc.Stats.Allocations <= limit)
+        return false;
+    return allocationBudgetFail("allocations", limit, unity_p->Malloc.Stats.Allocations, msg, line, file, unity_p);
+}
+
+bool UnityMalloc_AssertPeakBytes(unsigned long limit, const char * msg,
+                                 const UNITY_LINE_TYPE line, const char * file, struct _Unity * const unity_p)
+{
+    if (unity_p->CurrentTestFailed || unity_p->CurrentTestIgnored)
+        return true;
+    if (unity_p->Malloc.Stats.PeakBytes <= limit)
+        return false;
+    return allocationBudgetFail("peak bytes", limit, (unsigned long)unity_p->Malloc.Stats.PeakBytes, msg, line, file, unity_p);
+}
+
+#include <stdlib.h>
+#include <string.h>
+
+typedef struct GuardBytes
+{
+    size_t size;
+    size_t capacity;
+    unsigned int test;
+    _UU32 magic;
+    unsigned char offset;
+    unsigned char sizeClass;
+} Guard;
+
+/* DX_PATCH: with the allocation wrappers, free() also receives blocks this allocator never
+   handed out, e.g. from strdup() inside the C library. Our blocks carry a magic number in the
+   guard, and are placed so that the guard never starts on an earlier page than the block:
+   a pointer that lies at the very start of a page can then only be a foreign one, and for any
+   other pointer the guard bytes in front of it are mapped and can be read. The probe is a
+   heuristic: a foreign block that happens to follow the magic number would be taken for one
+   of ours, so it is only made in UNITY_WRAP_MALLOC builds. Without the wrappers only the
+   malloc macros lead here, and every pointer is taken to be ours.
+   A released block keeps GUARD_FREED in its guard, which catches a second free of it as
+   long as the block is still pooled or its memory has not been handed out again. */
+#define GUARD_MAGIC 0x554E4954u
+#define GUARD_FREED 0x46524545u
+#define GUARD_PAGE_SIZE 4096u
+// room for the guard in front of the memory, keeping the alignment of the system allocator
+#define GUARD_SPACE ((sizeof(Guard) + 15u) & ~(size_t)15u)
+#define GUARD_LARGE 0xFFu
+
+#if defined(__GNUC__)
+#define GUARD_NO_SANITIZE __attribute__((no_sanitize_address))
+#else
+#define GUARD_NO_SANITIZE
+#endif
+
+
+static const char * end = "END";
+#define END_SIZE 4u
+
+/* DX_PATCH: blocks up to UNITY_MALLOC_CLASS_MAX bytes come in power of two size classes and
+   are recycled through per-test free lists, larger ones grow by half their capacity. Together
+   with growing a block in place, by moving the END marker into its slack, a buffer that grows
+   byte by byte costs a logarithmic number of copies instead of one per byte. The lists are
+   handed back to the system when the test ends. */
+static unsigned int sizeClass(size_t capacity)
+{
+    unsigned int index = 0;
+    size_t classSize = UNITY_MALLOC_CLASS_MIN;
+
+    if (capacity > UNITY_MALLOC_CLASS_MAX)
+        return GUARD_LARGE;
+    while (classSize < capacity)
+    {
+        classSize *= 2;
+        index++;
+    }
+    return index;
+}
+
+static char * placeBlock(char * block, size_t size, size_t capacity, unsigned int index,
+                         const struct _UnityMallocState * state)
+{
+    char* mem = block + GUARD_SPACE;
+    Guard* guard;
+
+    if (((size_t)mem % GUARD_PAGE_SIZE) < sizeof(Guard))
+        mem += GUARD_SPACE;
+    guard = (Guard*)mem;
+    guard--;
+    guard->size = size;
+    guard->capacity = capacity;
+    guard->test = (state != NULL) ? state->TestId : 0;
+    guard->magic = GUARD_MAGIC;
+    guard->offset = (unsigned char)(mem - block);
+    guard->sizeClass = (unsigned char)index;
+    memcpy(&mem[size], end, END_SIZE);
+    return mem;
+}
+
+static void countAllocation(struct _UnityMallocState * state, size_t bytes)
+{
+    state->Stats.Bytes += bytes;
+    state->LiveBytes += bytes;
+    if (state->LiveBytes > state->Stats.PeakBytes)
+        state->Stats.PeakBytes = state->LiveBytes;
+}
+
+static void * allocateBlock(size_t size, struct _UnityMallocState * state)
+{
+    unsigned int index = sizeClass(size + END_SIZE);
+    size_t capacity;
+    char* block = NULL;
+
+    if (state != NULL)
+    {
+        state->Count++;
+        state->Stats.Allocations++;
+        countAllocation(state, size);
+    }
+
+    if (index == GUARD_LARGE)
+    {
+        capacity = size + END_SIZE;
+    }
+    else
+    {
+        capacity = (size_t)UNITY_MALLOC_CLASS_MIN << index;
+        if ((state != NULL) && (state->FreeLists[index] != NULL))
+        {
+            block = (char*)state->FreeLists[index];
+            state->FreeLists[index] = *(void **)block;
+            state->FreeCounts[index]--;
+        }
+    }
+    if (block == NULL)
+        block = (char*)UNITY_INTERNAL_MALLOC(capacity + 2 * GUARD_SPACE);
+    assert(block);
+
+    return (void*)placeBlock(block, size, capacity, index, state);
+}
+
+void * unity_malloc(size_t size)
+{
+    return unity_malloc_at(size, NULL, 0);
+}
+
+void * unity_malloc_at(size_t size, const char * file, int line)
+{
+    struct _UnityMallocState * state = currentState();
+
+    if ((state != NULL) && injectFailure(state, file, line))
+        return 0;
+    return allocateBlock(size, state);
+}
+
+#if defined(UNITY_WRAP_MALLOC)
+GUARD_NO_SANITIZE static int isForeign(void * mem)
+{
+    Guard* guard = (Guard*)mem;
+    guard--;
+
+    if (((size_t)mem % GUARD_PAGE_SIZE) < sizeof(Guard))
+        return 1;
+    return (guard->magic != GUARD_MAGIC) && (guard->magic != GUARD_FREED);
+}
+#else
+static int isForeign(void * mem)
+{
+    (void)mem;
+    return 0;
+}
+#endif
+
+GUARD_NO_SANITIZE static int isFreed(void * mem)
+{
+    Guard* guard = (Guard*)mem;
+    guard--;
+
+    return guard->magic == GUARD_FREED;
+}
+
+static int isOverrun(void * mem)
+{
+    Guard* guard = (Guard*)mem;
+    char* memAsChar = (char*)mem;
+    guard--;
+
+    return memcmp(&memAsChar[guard->size], end, END_SIZE) != 0;
+}
+
+static void release_memory(void * mem)
+{
+    struct _UnityMallocState * state = currentState();
+    Guard* guard = (Guard*)mem;
+    char* block;
+    unsigned int index;
+    guard--;
+
+    if ((state != NULL) && (guard->test == state->TestId))
+    {
+        state->Count--;
+        state->LiveBytes -= guard->size;
+    }
+    guard->magic = GUARD_FREED;
+    block = (char*)mem - guard->offset;
+    index = guard->sizeClass;
+    if ((state != NULL) && (index != GUARD_LARGE) && (state->FreeCounts[index] < UNITY_MALLOC_POOL_DEPTH))
+    {
+        *(void **)block = state->FreeLists[index];
+        state->FreeLists[index] = block;
+        state->FreeCounts[index]++;
+        return;
+    }
+    UNITY_INTERNAL_FREE(block);
+}
+
+void unity_free(void * mem)
+{
+    struct _Unity * const unity_p = malloc_context;
+    int overrun;
+
+    if (mem == 0)
+        return;
+    if (isForeign(mem))
+    {
+        UNITY_INTERNAL_FREE(mem);
+        return;
+    }
+    if (isFreed(mem))
+    {
+        if (unity_p != NULL)
+        {
+            TEST_FAIL_MESSAGE("Double free detected");
+        }
+        return;
+    }
+    overrun = isOverrun(mem);//strcmp(&memAsChar[guard->size], end) != 0;
+    release_memory(mem);
+    if (overrun && (unity_p != NULL))
+    {
+        TEST_FAIL_MESSAGE("Buffer overrun detected during free()");
+    }
+}
+
+void* unity_calloc(size_t num, size_t size)
+{
+    return unity_calloc_at(num, size, NULL, 0);
+}
+
+void* unity_calloc_at(size_t num, size_t size, const char * file, int line)
+{
+    void* mem = unity_malloc_at(num * size, file, line);
+    if (mem != 0)
+        memset(mem, 0, num*size);
+    return mem;
+}
+
+void* unity_realloc(void * oldMem, size_t size)
+{
+    return unity_realloc_at(oldMem, size, NULL, 0);
+}
+
+// Moves a large block to a bigger system block, the guard and contents keep their place
+// relative to the start of the block unless that would put the guard on the previous page.
+static char * growLarge(char * mem, size_t size, const struct _UnityMallocState * state)
+{
+    Guard* guard = ((Guard*)mem) - 1;
+    size_t capacity = guard->capacity + guard->capacity / 2;
+    size_t oldOffset = guard->offset;
+    size_t oldSize = guard->size;
+    char* block;
+    char* newMem;
+
+    if (capacity < size + END_SIZE)
+        capacity = size + END_SIZE;
+    block = (char*)UNITY_INTERNAL_REALLOC(mem - oldOffset, capacity + 2 * GUARD_SPACE);
+    if (block == NULL)
+        return NULL;
+    newMem = block + GUARD_SPACE;
+    if (((size_t)newMem % GUARD_PAGE_SIZE) < sizeof(Guard))
+        newMem += GUARD_SPACE;
+    if (newMem != block + oldOffset)
+        memmove(newMem, block + oldOffset, oldSize);
+    return placeBlock(block, size, capacity, GUARD_LARGE, state);
+}
+
+void* unity_realloc_at(void * oldMem, size_t size, const char * file, int line)
+{
+    struct _Unity * const unity_p = malloc_context;
+    struct _UnityMallocState * state = currentState();
+    Guard* guard = (Guard*)oldMem;
+//    char* memAsChar = (char*)oldMem;
+    void* newMem;
+    int counted;
+    size_t oldSize;
+
+    if (unity_p != NULL)
+        unity_p->Malloc.Stats.Reallocs++;
+    if (oldMem == 0)
+        return unity_malloc_at(size, file, line);
+    if (isForeign(oldMem))
+        return UNITY_INTERNAL_REALLOC(oldMem, size);
+    if (isFreed(oldMem))
+    {
+        if (unity_p != NULL)
+            UnityFail("Freed memory passed to realloc()", (UNITY_LINE_TYPE)__LINE__, __FILE__, true, unity_p);
+        return 0;
+    }
+
+    guard--;
+    if (isOverrun(oldMem))
+    {
+        release_memory(oldMem);
+        /*DX_PATCH for jumless version*/
+        if (unity_p != NULL)
+            UnityFail("Buffer overrun detected during realloc()", (UNITY_LINE_TYPE)__LINE__, __FILE__, true, unity_p);
+        return 0;
+    }
+
+    if (size == 0)
+    {
+        release_memory(oldMem);
+        return 0;
+    }
+
+    oldSize = guard->size;
+    counted = (state != NULL) && (guard->test == state->TestId);
+    if ((size > oldSize) && (state != NULL) && injectFailure(state, file, line))
+        return 0;
+
+    // in place, the END marker just moves
+    if (size + END_SIZE <= guard->capacity)
+    {
+        guard->size = size;
+        memcpy(&((char*)oldMem)[size], end, END_SIZE);
+        newMem = oldMem;
+    }
+    else if (guard->sizeClass == GUARD_LARGE)
+    {
+        newMem = growLarge((char*)oldMem, size, counted ? state : NULL);
+        if (newMem == 0)
+            return 0;
+    }
+    else
+    {
+        // a new block, which is counted on its own; a failure was already injected above
+        newMem = allocateBlock(size, state);
+        memcpy(newMem, oldMem, oldSize);
+        release_memory(oldMem);
+        return newMem;
+    }
+
+    if (counted)
+    {
+        if (size > oldSize)
+            countAllocation(state, size - oldSize);
+        else
+            state->LiveBytes -= oldSize - size;
+    }
+    return newMem;
+}
+
+#if defined(UNITY_WRAP_MALLOC)
+/* DX_PATCH: targets of the linker wrapping, see UNITY_WRAP_MALLOC */
+void * __wrap_malloc(size_t size);
+void * __wrap_calloc(size_t num, size_t size);
+void * __wrap_realloc(void * mem, size_t size);
+void __wrap_free(void * mem);
+
+void * __wrap_malloc(size_t size)
+{
+    return unity_malloc(size);
+}
+
+void * __wrap_calloc(size_t num, size_t size)
+{
+    return unity_calloc(num, size);
+}
+
+void * __wrap_realloc(void * mem, size_t size)
+{
+    return unity_realloc(mem, size);
+}
+
+void __wrap_free(void * mem)
+{
+    unity_free(mem);
+}
+#endif /* UNITY_WRAP_MALLOC */
+
+#endif /* UNITY_DYNAMIC_MEM_DEBUG */
+
+#if defined(UNITY_CPP_UNIT_COMPAT)
+
+//--------------------------------------------------------
+//Automatic pointer restoration functions
+/* DX_PATCH: the saved values live on a growable stack in the context, so there is no limit on
+   the number of sets, and parallel tests never share it. Each entry is the old value, padded
+   to the alignment of the record that follows it and describes where it goes back to. */
+typedef struct _RestoreRecord
+{
+    void * target;
+    size_t size;
+} RestoreRecord;
+
+#define RESTORE_ALIGN(size) (((size) + sizeof(RestoreRecord) - 1) / sizeof(RestoreRecord) * sizeof(RestoreRecord))
+
+void UnityPointer_Init( struct _Unity * const unity_p )
+{
+    unity_p->RestoreLength = 0;
+}
+
+void UnityValue_Set(void * target, const void * newValue, size_t size, struct _Unity * const unity_p)
+{
+    size_t needed = unity_p->RestoreLength + RESTORE_ALIGN(size) + sizeof(RestoreRecord);
+    RestoreRecord record;
+
+    if (needed > unity_p->RestoreCapacity)
+    {
+        size_t capacity = (unity_p->RestoreCapacity == 0) ? 256 : unity_p->RestoreCapacity * 2;
+        unsigned char * stack;
+
+        while (capacity < needed)
+            capacity *= 2;
+        stack = (unsigned char *)UNITY_INTERNAL_REALLOC(unity_p->RestoreStack, capacity);
+        if (stack == NULL)
+            TEST_FAIL_MESSAGE("Too many values set");
+        unity_p->RestoreStack = stack;
+        unity_p->RestoreCapacity = capacity;
+    }
+
+    memcpy(unity_p->RestoreStack + unity_p->RestoreLength, target, size);
+    record.target = target;
+    record.size = size;
+    memcpy(unity_p->RestoreStack + needed - sizeof(RestoreRecord), &record, sizeof(record));
+    unity_p->RestoreLength = needed;
+    memmove(target, newValue, size);
+}
+
+void UnityPointer_Set(void ** ptr, void * newValue, struct _Unity * const unity_p)
+{
+    UnityValue_Set(ptr, &newValue, sizeof(newValue), unity_p);
+}
+
+// Undone in reverse order, so a value set twice ends up with its original contents
+void UnityPointer_UndoAllSets( struct _Unity * const unity_p )
+{
+    RestoreRecord record;
+
+    while (unity_p->RestoreLength > 0)
+    {
+        unity_p->RestoreLength -= sizeof(RestoreRecord);
+        memcpy(&record, unity_p->RestoreStack + unity_p->RestoreLength, sizeof(record));
+        unity_p->RestoreLength -= RESTORE_ALIGN(record.size);
+        memcpy(record.target, unity_p->RestoreStack + unity_p->RestoreLength, record.size);
+    }
+    // released after every test, so that a copy of the context never shares the stack
+    UNITY_INTERNAL_FREE(unity_p->RestoreStack);
+    unity_p->RestoreStack = NULL;
+    unity_p->RestoreCapacity = 0;
+}
+
+#endif
+
+#if defined(UNITY_GOLDEN_FILES)
+//--------------------------------------------------------
+//Golden file assertions
+static bool goldenFileFail(const char * what, const char * path, const char * msg,
+                           const UNITY_LINE_TYPE line, const char * file, struct _Unity * const unity_p)
+{
+    const size_t size = strlen(what) + 1 + strlen(path) + 2 + ((msg != NULL) ? strlen(msg) : 0) + 1;
+    char * message = (char *)UNITY_INTERNAL_MALLOC(size);
+    bool failed;
+
+    if (message == NULL)
+        return UnityFail(what, line, file, true, unity_p);
+    snprintf(message, size, "%s %s%s%s", what, path,
+             (msg != NULL) ? ". " : "", (msg != NULL) ? msg : "");
+    failed = UnityFail(message, line, file, true, unity_p);
+    UNITY_INTERNAL_FREE(message);
+    return failed;
+}
+
+// Numbers the temporary files of one process, so tests that update the same golden file
+// at the same time under -j never write to the same temporary.
+static unsigned long goldenFileSequence;
+
+// The new contents go to a temporary file next to the golden one, which is then renamed
+// over it, so an interrupted run never leaves a truncated reference behind.
+static bool updateGoldenFile(const char * path, const void * actual, size_t length, const char * msg,
+                             const UNITY_LINE_TYPE line, const char * file, struct _Unity * const unity_p)
+{
+    const size_t size = strlen(path) + 48;
+    char * temporary = (char *)UNITY_INTERNAL_MALLOC(size);
+    const char * data = (const char *)actual;
+    ssize_t written;
+    bool failed;
+    int synced;
+    int closed;
+    int fd;
+
+    if (temporary == NULL)
+        return goldenFileFail("Out Of Memory For Golden File", path, msg, line, file, unity_p);
+    snprintf(temporary, size, "%s.%ld.%lu.tmp", path, (long)getpid(),
+             __atomic_fetch_add(&goldenFileSequence, 1, __ATOMIC_RELAXED));
+
+    fd = open(temporary, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0)
+    {
+        failed = goldenFileFail("Cannot Create Golden File", temporary, msg, line, file, unity_p);
+        UNITY_INTERNAL_FREE(temporary);
+        return failed;
+    }
+
+    while (length > 0)
+    {
+        written = write(fd, data, length);
+        if ((written < 0) && (errno == EINTR))
+            continue;
+        if (written < 0)
+        {
+            close(fd);
+            unlink(temporary);
+            failed = goldenFileFail("Cannot Write Golden File", temporary, msg, line, file, unity_p);
+            UNITY_INTERNAL_FREE(temporary);
+            return failed;
+        }
+        data += written;
+        length -= (size_t)written;
+    }
+
+    // the file is closed whether or not the sync worked
+    synced = (fsync(fd) == 0);
+    closed = (close(fd) == 0);
+    failed = false;
+    if (!synced || !closed || (rename(temporary, path) != 0))
+    {
+        unlink(temporary);
+        failed = goldenFileFail("Cannot Replace Golden File", path, msg, line, file, unity_p);
+    }
+    UNITY_INTERNAL_FREE(temporary);
+    return failed;
+}
+
+bool UnityAssertMatchesGoldenFile(const char * path,
+                                  const void * actual,
+                                  size_t length,
+                                  const char * msg,
+                                  const UNITY_LINE_TYPE line, const char * file, struct _Unity * const unity_p)
+{
+    struct stat info;
+    void * golden = NULL;
+    size_t goldenLength;
+    size_t common;
+    bool failed = false;
+    int fd;
+
+    if (unity_p->CurrentTestFailed || unity_p->CurrentTestIgnored)
+        return true;
+
+    if (unity_p->UpdateGolden)
+        return updateGoldenFile(path, actual, length, msg, line, file, unity_p);
+
+    fd = open(path, O_RDONLY);
+    if (fd < 0)
+        return goldenFileFail("Cannot Open Golden File", path, msg, line, file, unity_p);
+    if (fstat(fd, &info) != 0)
+    {
+        close(fd);
+        return goldenFileFail("Cannot Stat Golden File", path, msg, line, file, unity_p);
+    }
+    goldenLength = (size_t)info.st_size;
+
+    // the reference is compared straight from the page cache instead of a heap copy
+    if (goldenLength > 0)
+    {
+        golden = mmap(NULL, goldenLength, PROT_READ, MAP_PRIVATE, fd, 0);
+    }
+    close(fd);
+    if (golden == MAP_FAILED)
+        return goldenFileFail("Cannot Map Golden File", path, msg, line, file, unity_p);
+
+    common = (goldenLength < length) ? goldenLength : length;
+    if (common > (_UU32)-1)
+    {
+        failed = goldenFileFail("Golden File Too Large:", path, msg, line, file, unity_p);
+    }
+    else if (common > 0)
+    {
+        posix_madvise(golden, goldenLength, POSIX_MADV_SEQUENTIAL);
+        failed = UnityAssertEqualMemory(golden, actual, (_UU32)common, 1, msg, line, file, unity_p);
+    }
+
+    if (!failed && (goldenLength != length))
+    {
+        char what[96];
+        snprintf(what, sizeof(what), "Golden File Size Mismatch. Expected %lu Was %lu:",
+                 (unsigned long)goldenLength, (unsigned long)length);
+        failed = goldenFileFail(what, path, msg, line, file, unity_p);
+    }
+
+    if (golden != NULL)
+    {
+        munmap(golden, goldenLength);
+    }
+    return failed;
+}
+#endif /* UNITY_GOLDEN_FILES */
+
+#if defined(UNITY_PERF_COUNTERS)
+//--------------------------------------------------------
+//Performance counters
+/* DX_PATCH: New feature - --perf-counters cycles,instructions,... The counters are opened with
+   perf_event_open for the calling thread around the body of each test, so a parallel worker
+   only counts its own test. The first counter leads a group that the others join, so they are
+   scheduled together; one that does not fit the group is counted on its own, and a value is
+   scaled up when the kernel had to multiplex its counter. Without a hardware PMU, as in most
+   virtual machines, cycles fall back to the cpu-clock software event, in nanoseconds. */
+typedef struct _UnityPerfEvent
+{
+    const char * name;
+    uint32_t type;
+    uint64_t config;
+    int fallback;   // index of the software event counted instead, -1 for none
+} UnityPerfEvent;
+
+enum { PERF_EVENT_CPU_CLOCK = 5 };
+
+static const UnityPerfEvent perfEvents[] =
+{
+    { "cycles",           PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES,       PERF_EVENT_CPU_CLOCK },
+    { "instructions",     PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS,     -1 },
+    { "cache-misses",     PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES,     -1 },
+    { "branch-misses",    PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES,    -1 },
+    { "page-faults",      PERF_TYPE_SOFTWARE, PERF_COUNT_SW_PAGE_FAULTS,      -1 },
+    { "cpu-clock",        PERF_TYPE_SOFTWARE, PERF_COUNT_SW_CPU_CLOCK,        -1 },
+    { "task-clock",       PERF_TYPE_SOFTWARE, PERF_COUNT_SW_TASK_CLOCK,       -1 },
+    { "context-switches", PERF_TYPE_SOFTWARE, PERF_COUNT_SW_CONTEXT_SWITCHES, -1 },
+};
+
+#define PERF_EVENT_TYPES (sizeof(perfEvents) / sizeof(perfEvents[0]))
+
+// Selects a comma separated list of counters, nonzero for an unknown name or too many of them
+int UnityPerf_Select(const char * list, struct _Unity * const unity_p)
+{
+    struct _UnityPerfCounters * perf = &unity_p->Perf;
+
+    perf->EventCount = 0;
+    while (*list != '\0')
+    {
+        size_t length = strcspn(list, ",");
+        unsigned int type;
+
+        for (type = 0; type < PERF_EVENT_TYPES; type++)
+        {
+            if ((strlen(perfEvents[type].name) == length) && (strncmp(perfEvents[type].name, list, length) == 0))
+                break;
+        }
+        if ((type == PERF_EVENT_TYPES) || (perf->EventCount == UNITY_PERF_MAX_EVENTS))
+            return 1;
+        perf->Events[perf->EventCount++] = (unsigned char)type;
+        list += length;
+        if (*list == ',')
+            list++;
+    }
+    return 0;
+}
+
+static int perfOpen(const UnityPerfEvent * event, int group)
+{
+    struct perf_event_attr attr;
+
+    memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = event->type;
+    attr.config = event->config;
+    attr.disabled = (group < 0);
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+    return (int)syscall(SYS_perf_event_open, &attr, 0, -1, group, 0);
+}
+
+static int perfOpenInGroup(const UnityPerfEvent * event, int leader)
+{
+    int fd = perfOpen(event, leader);
+
+    if ((fd < 0) && (leader >= 0))
+        fd = perfOpen(event, -1);
+    return fd;
+}
+
+void UnityPerf_Start(struct _UnityPerfCounters * perf)
+{
+    int leader = -1;
+    unsigned int i;
+
+    for (i = 0; i < perf->EventCount; i++)
+    {
+        const UnityPerfEvent * event = &perfEvents[perf->Events[i]];
+        int fd = perfOpenInGroup(event, leader);
+
+        if ((fd < 0) && (event->fallback >= 0))
+        {
+            event = &perfEvents[event->fallback];
+            fd = perfOpenInGroup(event, leader);
+        }
+        perf->Fd[i] = fd;
+        perf->Name[i] = event->name;
+        perf->Value[i] = 0;
+        perf->Valid[i] = 0;
+        if ((fd >= 0) && (leader < 0))
+            leader = fd;
+    }
+
+    // the leader last, so that the whole group starts at once
+    for (i = perf->EventCount; i > 0; i--)
+    {
+        if (perf->Fd[i - 1] >= 0)
+        {
+            ioctl(perf->Fd[i - 1], PERF_EVENT_IOC_RESET, 0);
+            ioctl(perf->Fd[i - 1], PERF_EVENT_IOC_ENABLE, 0);
+        }
+    }
+}
+
+// A counter the kernel had to multiplex only ran for part of the time it was enabled
+unsigned long long UnityPerf_Scale(unsigned long long value, unsigned long long enabled, unsigned long long running)
+{
+    if ((running == 0) || (running >= enabled))
+        return value;
+    return (unsigned long long)((double)value * (double)enabled / (double)running);
+}
+
+void UnityPerf_Stop(struct _UnityPerfCounters * perf)
+{
+    unsigned int i;
+
+    for (i = 0; i < perf->EventCount; i++)
+    {
+        if (perf->Fd[i] >= 0)
+            ioctl(perf->Fd[i], PERF_EVENT_IOC_DISABLE, 0);
+    }
+    for (i = 0; i < perf->EventCount; i++)
+    {
+        uint64_t values[3];   // value, time enabled, time running
+
+        if (perf->Fd[i] < 0)
+            continue;
+        if ((read(perf->Fd[i], values, sizeof(values)) == (ssize_t)sizeof(values)) && (values[2] > 0))
+        {
+            perf->Value[i] = UnityPerf_Scale(values[0], values[1], values[2]);
+            perf->Valid[i] = 1;
+        }
+        close(perf->Fd[i]);
+        perf->Fd[i] = -1;
+    }
+}
+
+void UnityPerf_Print(struct _Unity * const unity_p)
+{
+    const struct _UnityPerfCounters * perf = &unity_p->Perf;
+    unsigned int i;
+
+    for (i = 0; i < perf->EventCount; i++)
+    {
+        UnityPrint((i == 0) ? " [" : ", ", unity_p);
+        UnityPrint(perf->Name[i], unity_p);
+        if (perf->Valid[i])
+        {
+            UNITY_PRINT_CHAR(' ', unity_p);
+            UnityPrintNumberUnsigned((_U_UINT)perf->Value[i], unity_p);
+        }
+        else
+        {
+            UnityPrint(" n/a", unity_p);
+        }
+    }
+    if (perf->EventCount > 0)
+        UNITY_PRINT_CHAR(']', unity_p);
+}
+#endif /* UNITY_PERF_COUNTERS */
+
+#if defined(UNITY_BENCHMARK)
+//--------------------------------------------------------
+//Benchmarks
+/* DX_PATCH: New feature - TEST_BENCHMARK timing. A batch is timed with the cycle counter of the
+   processor: rdtsc between lfence on x86, which needs an invariant TSC, and cntvct_el0 behind isb
+   on aarch64. The fences keep the work of the batch from starting before the first read or from
+   retiring after the second. The length of a tick is calibrated once against CLOCK_MONOTONIC;
+   any other processor, or a build with UNITY_BENCH_MONOTONIC_CLOCK, times with clock_gettime.
+   What the two timer reads and the loop itself cost is measured along with the calibration and
+   subtracted from every sample, so that a nanosecond sized body is not dominated by them. */
+#define BENCH_CALIBRATION_NS        20000000ull
+#define BENCH_OVERHEAD_ITERATIONS   (1ul << 20)
+
+typedef struct _UnityBenchTimer
+{
+    const char * name;
+    int cycleCounter;
+    double nsPerTick;
+    double batchNs;     // an empty batch, the two timer reads
+    double loopNs;      // one iteration of an empty UNITY_BENCH_LOOP
+    double memcpyGbps;  // reference bandwidths, 0 when the buffers could not be allocated
+    double memsetGbps;
+    unsigned char * sweep;  // UNITY_BENCH_REFERENCE_BYTES evicting the caches in UNITY_BENCH_COLD
+} UnityBenchTimer;
+
+static UnityBenchTimer benchTimer;
+static int benchTimerState;     // 0 not calibrated, 1 calibrating, 2 ready
+
+static unsigned long long monotonicNs(void)
+{
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (unsigned long long)now.tv_sec * 1000000000ull + (unsigned long long)now.tv_nsec;
+}
+
+#if !defined(UNITY_BENCH_MONOTONIC_CLOCK) && (defined(__x86_64__) || defined(__i386__))
+#define BENCH_CYCLE_COUNTER "rdtsc"
+static inline unsigned long long readCycleCounter(void)
+{
+    unsigned int low, high;
+
+    __asm__ volatile("lfence\n\trdtsc\n\tlfence" : "=a"(low), "=d"(high) : : "memory");
+    return ((unsigned long long)high << 32) | low;
+}
+
+static int cycleCounterUsable(void)
+{
+    unsigned int eax, ebx, ecx, edx;
+
+    // CPUID 80000007h EDX bit 8, the TSC runs at a constant rate in every P-, C- and T-state
+    return __get_cpuid(0x80000007u, &eax, &ebx, &ecx, &edx) && ((edx & (1u << 8)) != 0);
+}
+#elif !defined(UNITY_BENCH_MONOTONIC_CLOCK) && defined(__aarch64__)
+#define BENCH_CYCLE_COUNTER "cntvct"
+static inline unsigned long long readCycleCounter(void)
+{
+    unsigned long long ticks;
+
+    __asm__ volatile("isb\n\tmrs %0, cntvct_el0\n\tisb" : "=r"(ticks) : : "memory");
+    return ticks;
+}
+
+static int cycleCounterUsable(void)
+{
+    return 1;
+}
+#endif
+
+static inline unsigned long long benchTicks(void)
+{
+#if defined(BENCH_CYCLE_COUNTER)
+    if (benchTimer.cycleCounter)
+        return readCycleCounter();
+#endif
+    return monotonicNs();
+}
+
+static double minimumOf(double current, double value)
+{
+    return ((current < 0.0) || (value < current)) ? value : current;
+}
+
+static void measureOverhead(void)
+{
+    UnityBenchmark probe;
+    UnityBenchmark * const bench = &probe;
+    double emptyNs = -1.0;
+    double loopNs = -1.0;
+    int round;
+
+    memset(&probe, 0, sizeof(probe));
+    for (round = 0; round < 16; round++)
+    {
+        probe.Iterations = 0;
+        UNITY_BENCH_LOOP
+        {
+            UNITY_BENCH_CLOBBER();
+        }
+        emptyNs = minimumOf(emptyNs, probe.BatchNs);
+    }
+    for (round = 0; round < 8; round++)
+    {
+        probe.Iterations = BENCH_OVERHEAD_ITERATIONS;
+        UNITY_BENCH_LOOP
+        {
+            UNITY_BENCH_CLOBBER();
+        }
+        loopNs = minimumOf(loopNs, probe.BatchNs);
+    }
+    benchTimer.batchNs = emptyNs;
+    benchTimer.loopNs = (loopNs > emptyNs) ? (loopNs - emptyNs) / (double)BENCH_OVERHEAD_ITERATIONS : 0.0;
+}
+
+/* DX_PATCH: the memcpy and memset bandwidths of buffers larger than the caches, the best of a
+   few passes, as a yardstick for benchmarks that set their bytes. They are bandwidths to DRAM, so
+   an input that stays in a cache can run at several times them. */
+static void measureBandwidth(void)
+{
+    unsigned char * source = (unsigned char *)UNITY_INTERNAL_MALLOC(UNITY_BENCH_REFERENCE_BYTES);
+    unsigned char * destination = (unsigned char *)UNITY_INTERNAL_MALLOC(UNITY_BENCH_REFERENCE_BYTES);
+    double copyNs = -1.0;
+    double setNs = -1.0;
+    int round;
+
+    benchTimer.memcpyGbps = 0.0;
+    benchTimer.memsetGbps = 0.0;
+    if ((source != NULL) && (destination != NULL))
+    {
+        // the first pass also faults the pages in
+        memset(source, 1, UNITY_BENCH_REFERENCE_BYTES);
+        memset(destination, 2, UNITY_BENCH_REFERENCE_BYTES);
+        for (round = 0; round < 3; round++)
+        {
+            unsigned long long start = benchTicks();
+
+            memcpy(destination, source, UNITY_BENCH_REFERENCE_BYTES);
+            UNITY_BENCH_CLOBBER();
+            copyNs = minimumOf(copyNs, (double)(benchTicks() - start) * benchTimer.nsPerTick);
+            start = benchTicks();
+            memset(destination, round, UNITY_BENCH_REFERENCE_BYTES);
+            UNITY_BENCH_CLOBBER();
+            setNs = minimumOf(setNs, (double)(benchTicks() - start) * benchTimer.nsPerTick);
+        }
+        // bytes per nanosecond are gigabytes per second
+        benchTimer.memcpyGbps = (copyNs > 0.0) ? (double)UNITY_BENCH_REFERENCE_BYTES / copyNs : 0.0;
+        benchTimer.memsetGbps = (setNs > 0.0) ? (double)UNITY_BENCH_REFERENCE_BYTES / setNs : 0.0;
+    }
+    // the source is kept as the sweep buffer of UNITY_BENCH_COLD
+    benchTimer.sweep = source;
+    UNITY_INTERNAL_FREE(destination);
+}
+
+static void calibrateTimer(void)
+{
+    benchTimer.name = "clock_gettime";
+    benchTimer.cycleCounter = 0;
+    benchTimer.nsPerTick = 1.0;
+#if defined(BENCH_CYCLE_COUNTER)
+    if (cycleCounterUsable())
+    {
+        unsigned long long startNs = monotonicNs();
+        unsigned long long startTicks = readCycleCounter();
+        unsigned long long endNs, endTicks;
+
+        do
+        {
+            endNs = monotonicNs();
+            endTicks = readCycleCounter();
+        } while (endNs - startNs < BENCH_CALIBRATION_NS);
+        if (endTicks > startTicks)
+        {
+            benchTimer.name = BENCH_CYCLE_COUNTER;
+            benchTimer.cycleCounter = 1;
+            benchTimer.nsPerTick = (double)(endNs - startNs) / (double)(endTicks - startTicks);
+        }
+    }
+#endif
+    measureOverhead();
+    measureBandwidth();
+}
+
+// The first benchmark calibrates, in a parallel run the others wait for it
+static void benchTimerInit(void)
+{
+    int state = 0;
+
+    if (__atomic_load_n(&benchTimerState, __ATOMIC_ACQUIRE) == 2)
+        return;
+    if (__atomic_compare_exchange_n(&benchTimerState, &state, 1, false, __ATOMIC_ACQUIRE, __ATOMIC_RELAXED))
+    {
+        calibrateTimer();
+        __atomic_store_n(&benchTimerState, 2, __ATOMIC_RELEASE);
+    }
+    while (__atomic_load_n(&benchTimerState, __ATOMIC_ACQUIRE) != 2)
+        ;
+}
+
+unsigned long long UnityBench_Ticks(void)
+{
+    return benchTicks();
+}
+
+// What the first benchmark measured, for the tests of the harness
+void UnityBench_Calibration(double * nsPerTick, double * batchNs, double * loopNs)
+{
+    benchTimerInit();
+    *nsPerTick = benchTimer.nsPerTick;
+    *batchNs = benchTimer.batchNs;
+    *loopNs = benchTimer.loopNs;
+}
+
+void UnityBench_ReferenceBandwidths(double * memcpyGbps, double * memsetGbps)
+{
+    benchTimerInit();
+    *memcpyGbps = benchTimer.memcpyGbps;
+    *memsetGbps = benchTimer.memsetGbps;
+}
+
+static unsigned long long threadCpuNs(void)
+{
+    struct timespec now;
+
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &now);
+    return (unsigned long long)now.tv_sec * 1000000000ull + (unsigned long long)now.tv_nsec;
+}
+
+void UnityBench_Init(UnityBenchmark * bench, const char * name, struct _Unity * const unity_p)
+{
+    memset(bench, 0, sizeof(*bench));
+    bench->Name = name;
+    bench->Unity = unity_p;
+    bench->Iterations = 1;
+    bench->Calibrating = 1;
+    bench->Complexity = -1;
+    bench->CacheMode = unity_p->BenchCacheMode;
+    bench->Copies = unity_p->BenchRotateCopies;
+#if defined(UNITY_PERF_COUNTERS)
+    bench->Perf.EventCount = unity_p->Perf.EventCount;
+    memcpy(bench->Perf.Events, unity_p->Perf.Events, sizeof(bench->Perf.Events));
+#endif
+    benchTimerInit();
+    bench->Random = (unsigned int)benchTicks() | 1u;
+}
+
+//--------------------------------------------------------
+//Benchmark cache modes
+/* DX_PATCH: New feature - UNITY_BENCH_SET_CACHE / --cache-mode. Before every iteration the timer is
+   paused while UNITY_BENCH_COLD reads every cache line of a buffer larger than the last level
+   cache, UNITY_BENCH_FLUSH flushes the lines of the input (clflush on x86, dc civac on aarch64),
+   or UNITY_BENCH_ROTATE moves the input pointer to the next of its copies. Each copy starts a page
+   of its own; unless a number of them is asked for, they add up to UNITY_BENCH_REFERENCE_BYTES or
+   more, and they are visited in a shuffled order the prefetchers cannot follow. A mode that
+   cannot be had, such as a flush without an input, falls back to a sweep; the mode the samples
+   were actually taken in is what the result records. Perf counters still count the preparation. */
+static const char * const cacheModeNames[] = { "hot", "cold", "flush", "rotate" };
+
+#if defined(__x86_64__) || defined(__i386__) || defined(__aarch64__)
+#define BENCH_CACHE_FLUSH
+static void flushRange(const void * start, size_t bytes)
+{
+    const unsigned char * line = (const unsigned char *)((uintptr_t)start & ~(uintptr_t)(UNITY_CACHE_LINE_SIZE - 1));
+    const unsigned char * end = (const unsigned char *)start + bytes;
+
+    for (; line < end; line += UNITY_CACHE_LINE_SIZE)
+    {
+#if defined(__aarch64__)
+        __asm__ volatile("dc civac, %0" : : "r"(line) : "memory");
+#else
+        __asm__ volatile("clflush (%0)" : : "r"(line) : "memory");
+#endif
+    }
+#if defined(__aarch64__)
+    __asm__ volatile("dsb ish" : : : "memory");
+#else
+    __asm__ volatile("mfence" : : : "memory");
+#endif
+}
+#endif
+
+static void sweepCaches(void)
+{
+    const volatile unsigned char * sweep = benchTimer.sweep;
+    unsigned char sum = 0;
+    size_t i;
+
+    for (i = 0; i < UNITY_BENCH_REFERENCE_BYTES; i += UNITY_CACHE_LINE_SIZE)
+        sum = (unsigned char)(sum + sweep[i]);
+    UNITY_BENCH_DO_NOT_OPTIMIZE(sum);
+}
+
+// hot, cold, flush, rotate or rotate:copies, nonzero for anything else
+int UnityBench_SelectCacheMode(const char * mode, struct _Unity * const unity_p)
+{
+    int i;
+
+    unity_p->BenchRotateCopies = 0;
+    if (strncmp(mode, "rotate:", 7) == 0)
+    {
+        unity_p->BenchCacheMode = UNITY_BENCH_ROTATE;
+        unity_p->BenchRotateCopies = (unsigned int)strtoul(mode + 7, NULL, 10);
+        return 0;
+    }
+    for (i = 0; i < (int)(sizeof(cacheModeNames) / sizeof(cacheModeNames[0])); i++)
+    {
+        if (strcmp(mode, cacheModeNames[i]) == 0)
+        {
+            unity_p->BenchCacheMode = i;
+            return 0;
+        }
+    }
+    return 1;
+}
+
+void UnityBench_SetInput(UnityBenchmark * bench, void * pointer, size_t bytes)
+{
+    bench->InputPointer = pointer;
+    memcpy(&bench->Input, pointer, sizeof(bench->Input));
+    bench->InputBytes = bytes;
+}
+
+// xorshift32, seeded from the clock for every benchmark
+static unsigned int benchRandom(UnityBenchmark * bench)
+{
+    bench->Random ^= bench->Random << 13;
+    bench->Random ^= bench->Random >> 17;
+    bench->Random ^= bench->Random << 5;
+    return bench->Random;
+}
+
+static void freeCopies(UnityBenchmark * bench)
+{
+    UNITY_INTERNAL_FREE(bench->CopyBuffer);
+    UNITY_INTERNAL_FREE(bench->CopyOrder);
+    bench->CopyBuffer = NULL;
+    bench->CopyOrder = NULL;
+}
+
+// The copies of the input and the order they are visited in, made once for every size of it
+static int makeCopies(UnityBenchmark * bench)
+{
+    long page = sysconf(_SC_PAGESIZE);
+    size_t stride = bench->InputBytes;
+    size_t count = bench->Copies;
+    size_t i;
+
+    if (page > 0)
+        stride = (stride + (size_t)page - 1) & ~((size_t)page - 1);
+    if (count == 0)
+        count = (UNITY_BENCH_REFERENCE_BYTES + stride - 1) / stride;
+    if (count < 2)
+        count = 2;
+    if ((bench->CopyBuffer != NULL) && (bench->CopyStride == stride) && (bench->CopyCount == count))
+        return 1;
+
+    freeCopies(bench);
+    if ((count > (unsigned int)-1) || (stride > (size_t)-1 / count))
+        return 0;
+    bench->CopyBuffer = (unsigned char *)UNITY_INTERNAL_MALLOC(stride * count);
+    bench->CopyOrder = (unsigned int *)UNITY_INTERNAL_MALLOC(sizeof(unsigned int) * count);
+    if ((bench->CopyBuffer == NULL) || (bench->CopyOrder == NULL))
+    {
+        freeCopies(bench);
+        return 0;
+    }
+    for (i = 0; i < count; i++)
+    {
+        size_t j = benchRandom(bench) % (i + 1);
+
+        memcpy(bench->CopyBuffer + i * stride, bench->Input, bench->InputBytes);
+        // the inside-out Fisher-Yates shuffle
+        bench->CopyOrder[i] = bench->CopyOrder[j];
+        bench->CopyOrder[j] = (unsigned int)i;
+    }
+    bench->CopyStride = stride;
+    bench->CopyCount = (unsigned int)count;
+    bench->CopyIndex = 0;
+    return 1;
+}
+
+static void resolveCacheMode(UnityBenchmark * bench)
+{
+    if ((bench->CacheMode == UNITY_BENCH_ROTATE) &&
+        ((bench->InputPointer == NULL) || (bench->InputBytes == 0) || !makeCopies(bench)))
+        bench->CacheMode = UNITY_BENCH_COLD;
+#if defined(BENCH_CACHE_FLUSH)
+    if ((bench->CacheMode == UNITY_BENCH_FLUSH) && ((bench->Input == NULL) || (bench->InputBytes == 0)))
+        bench->CacheMode = UNITY_BENCH_COLD;
+#else
+    if (bench->CacheMode == UNITY_BENCH_FLUSH)
+        bench->CacheMode = UNITY_BENCH_COLD;
+#endif
+    if ((bench->CacheMode == UNITY_BENCH_COLD) && (benchTimer.sweep == NULL))
+        bench->CacheMode = UNITY_BENCH_HOT;
+}
+
+// Runs before every iteration of a batch that is not hot, so always true
+int UnityBench_Prepare(UnityBenchmark * bench)
+{
+    unsigned long long paused = benchTicks();
+
+    switch (bench->CacheMode)
+    {
+        case UNITY_BENCH_COLD:
+            sweepCaches();
+            break;
+#if defined(BENCH_CACHE_FLUSH)
+        case UNITY_BENCH_FLUSH:
+            flushRange(bench->Input, bench->InputBytes);
+            break;
+#endif
+        case UNITY_BENCH_ROTATE:
+        {
+            void * copy = bench->CopyBuffer + (size_t)bench->CopyOrder[bench->CopyIndex] * bench->CopyStride;
+
+            memcpy(bench->InputPointer, &copy, sizeof(copy));
+            bench->CopyIndex = (bench->CopyIndex + 1 < bench->CopyCount) ? bench->CopyIndex + 1 : 0;
+            break;
+        }
+        default:
+            break;
+    }
+    bench->Pauses++;
+    bench->PausedTicks += benchTicks() - paused;
+    return 1;
+}
+
+unsigned long UnityBench_Start(UnityBenchmark * bench)
+{
+    bench->Batches++;
+    if (bench->CacheMode != UNITY_BENCH_HOT)
+        resolveCacheMode(bench);
+    bench->PausedTicks = 0;
+    bench->Pauses = 0;
+#if defined(UNITY_PERF_COUNTERS)
+    if (!bench->Calibrating && (bench->Perf.EventCount > 0))
+        UnityPerf_Start(&bench->Perf);
+#endif
+    bench->StartCpuNs = threadCpuNs();
+    bench->StartTicks = benchTicks();
+    return bench->Iterations;
+}
+
+// Ends the timed loop, so always false
+int UnityBench_Stop(UnityBenchmark * bench)
+{
+    unsigned long long end = benchTicks();
+
+    bench->PreparedNs = (double)bench->PausedTicks * benchTimer.nsPerTick;
+    bench->BatchNs = (double)(end - bench->StartTicks - bench->PausedTicks) * benchTimer.nsPerTick;
+    bench->BatchCpuNs = (double)(threadCpuNs() - bench->StartCpuNs) - bench->PreparedNs;
+#if defined(UNITY_PERF_COUNTERS)
+    if (!bench->Calibrating && (bench->Perf.EventCount > 0))
+    {
+        unsigned int i;
+
+        UnityPerf_Stop(&bench->Perf);
+        for (i = 0; i < bench->Perf.EventCount; i++)
+            bench->Points[bench->PointCount + bench->Variant].CountersPerOp[i] += (double)bench->Perf.Value[i];
+    }
+#endif
+    return 0;
+}
+
+void UnityBench_SetRange(UnityBenchmark * bench, unsigned long first, unsigned long last, unsigned long multiplier)
+{
+    bench->N = first;
+    bench->RangeEnd = last;
+    bench->RangeMultiplier = (multiplier < 2) ? 2 : multiplier;
+}
+
+void UnityBench_SetCompare(UnityBenchmark * bench, const char * implA, const char * implB, double percent)
+{
+    bench->Variants[0] = implA;
+    bench->Variants[1] = implB;
+    bench->MinSpeedup = percent / 100.0;
+}
+
+static double medianOf(const double * values, unsigned int count, double * minimum)
+{
+    double sorted[UNITY_BENCH_MAX_SAMPLES] = { 0.0 };
+    unsigned int i, j;
+
+    if (count == 0)
+        return 0.0;
+    for (i = 0; i < count; i++)
+    {
+        for (j = i; (j > 0) && (sorted[j - 1] > values[i]); j--)
+            sorted[j] = sorted[j - 1];
+        sorted[j] = values[i];
+    }
+    if (minimum != NULL)
+        *minimum = sorted[0];
+    return (count % 2) ? sorted[count / 2] : 0.5 * (sorted[count / 2 - 1] + sorted[count / 2]);
+}
+
+/* DX_PATCH: the spread of the samples, as their standard deviation relative to their mean. Samples
+   spread wider than --max-cv are taken again, since a migration, an interrupt storm or a change
+   of clock rate during one of them says more about the machine than about the code. */
+static double variationOf(const double * values, unsigned int count)
+{
+    double mean = 0.0, squares = 0.0;
+    unsigned int i;
+
+    if (count < 2)
+        return 0.0;
+    for (i = 0; i < count; i++)
+        mean += values[i];
+    mean /= (double)count;
+    for (i = 0; i < count; i++)
+        squares += (values[i] - mean) * (values[i] - mean);
+    return (mean > 0.0) ? squareRoot(squares / (double)(count - 1)) / mean : 0.0;
+}
+
+// Median and minimum of the samples taken for the current N
+static void finishPoint(UnityBenchmark * bench)
+{
+    UnityBenchPoint * point = &bench->Points[bench->PointCount++];
+
+    point->N = bench->N;
+    point->Iterations = bench->Iterations;
+    point->NsPerOp = medianOf(point->RealNs, point->SampleCount, &point->MinNsPerOp);
+    point->CpuNsPerOp = medianOf(point->CpuNs, point->SampleCount, NULL);
+    point->BytesPerOp = bench->BytesPerOp;
+    point->ItemsPerOp = bench->ItemsPerOp;
+    point->CacheMode = bench->CacheMode;
+    point->Copies = (bench->CacheMode == UNITY_BENCH_ROTATE) ? bench->CopyCount : 0;
+#if defined(UNITY_PERF_COUNTERS)
+    {
+        unsigned int i;
+
+        for (i = 0; i < bench->Perf.EventCount; i++)
+        {
+            point->CountersPerOp[i] /= (double)point->SampleCount * (double)bench->Iterations;
+            point->CounterValid[i] = bench->Perf.Valid[i];
+        }
+    }
+#endif
+}
+
+static void recordSample(const UnityBenchmark * bench, UnityBenchPoint * point)
+{
+    // every pause for the caches adds another pair of timer reads
+    double perOp = (bench->BatchNs - benchTimer.batchNs * (double)(1 + bench->Pauses)) / (double)bench->Iterations - benchTimer.loopNs;
+
+    point->RealNs[point->SampleCount] = (perOp > 0.0) ? perOp : 0.0;
+    point->CpuNs[point->SampleCount] = bench->BatchCpuNs / (double)bench->Iterations;
+    point->SampleCount++;
+}
+
+/* DX_PATCH: a comparison runs its pairs of batches in random order, A then B or B then A, so that
+   drift in clock rate or temperature hits both implementations alike instead of favouring the one
+   that happens to run second. Each pair gives one ratio. */
+static int randomVariant(UnityBenchmark * bench)
+{
+    return (int)(benchRandom(bench) & 1u);
+}
+
+static int nextComparison(UnityBenchmark * bench)
+{
+    recordSample(bench, &bench->Points[bench->Variant]);
+    if (!bench->SecondOfPair)
+    {
+        bench->SecondOfPair = 1;
+        bench->Variant = !bench->Variant;
+        return 1;
+    }
+    bench->SecondOfPair = 0;
+    if (bench->Points[0].SampleCount < UNITY_BENCH_COMPARE_PAIRS)
+    {
+        bench->Variant = randomVariant(bench);
+        return 1;
+    }
+    bench->Points[0].Cv = variationOf(bench->Points[0].RealNs, bench->Points[0].SampleCount);
+    bench->Points[1].Cv = variationOf(bench->Points[1].RealNs, bench->Points[1].SampleCount);
+    finishPoint(bench);
+    finishPoint(bench);
+    bench->Variant = 0;
+    return 0;
+}
+
+// Nonzero while the body has to run another batch
+int UnityBench_Next(UnityBenchmark * bench)
+{
+    UnityBenchPoint * point = &bench->Points[bench->PointCount];
+    double maxCv = bench->Unity->BenchMaxCv;
+
+    if (bench->Unity->CurrentTestFailed || (bench->Batches == 0))
+        return 0;
+    if (bench->Calibrating)
+    {
+        // a batch that prepares the caches takes as long as that, even though it is not counted
+        double batchNs = bench->BatchNs + bench->PreparedNs;
+
+        if ((batchNs < UNITY_BENCH_MIN_TIME_NS) && (bench->Iterations < UNITY_BENCH_MAX_ITERATIONS))
+        {
+            // aim a little past the minimum, but never grow more than a hundredfold at once
+            double factor = (batchNs > 0.0) ? 1.4 * UNITY_BENCH_MIN_TIME_NS / batchNs : 100.0;
+
+            if (factor > 100.0)
+                factor = 100.0;
+            if (factor < 2.0)
+                factor = 2.0;
+            bench->Iterations = (factor * (double)bench->Iterations < (double)UNITY_BENCH_MAX_ITERATIONS) ?
+                                (unsigned long)(factor * (double)bench->Iterations) : UNITY_BENCH_MAX_ITERATIONS;
+            return 1;
+        }
+        // a comparison calibrates on A, and B runs batches of the same size
+        bench->Calibrating = 0;
+        if (bench->Variants[0] != NULL)
+            bench->Variant = randomVariant(bench);
+        return 1;
+    }
+
+    if (bench->Variants[0] != NULL)
+        return nextComparison(bench);
+    recordSample(bench, point);
+    if (point->SampleCount < UNITY_BENCH_REPETITIONS)
+        return 1;
+
+    point->Cv = variationOf(point->RealNs, point->SampleCount);
+    if ((maxCv > 0.0) && (point->Cv > maxCv))
+    {
+        if (point->Reruns < UNITY_BENCH_MAX_RERUNS)
+        {
+            point->Reruns++;
+            point->SampleCount = 0;
+#if defined(UNITY_PERF_COUNTERS)
+            memset(point->CountersPerOp, 0, sizeof(point->CountersPerOp));
+#endif
+            return 1;
+        }
+        point->Unreliable = 1;
+    }
+    finishPoint(bench);
+    if ((bench->RangeMultiplier == 0) || (bench->PointCount == UNITY_BENCH_MAX_POINTS) ||
+        (bench->N >= bench->RangeEnd))
+        return 0;
+    // the range always ends with hi itself, also when hi is no power of the multiplier from lo
+    if (bench->N == 0)
+        bench->N = 1;
+    else if (bench->N > bench->RangeEnd / bench->RangeMultiplier)
+        bench->N = bench->RangeEnd;
+    else
+        bench->N *= bench->RangeMultiplier;
+    bench->Iterations = 1;
+    bench->Calibrating = 1;
+    return 1;
+}
+
+// Printed names, and the big_o names of the JSON output
+static const char * const complexityNames[] = { "O(1)", "O(log n)", "O(n)", "O(n log n)", "O(n^2)" };
+static const char * const complexityBigO[] = { "(1)", "lgN", "N", "NlgN", "N^2" };
+
+#define COMPLEXITY_CLASSES (int)(sizeof(complexityNames) / sizeof(complexityNames[0]))
+
+static double complexityOf(int complexity, double n)
+{
+    switch (complexity)
+    {
+        case 0:  return 1.0;
+        case 1:  return (n > 1.0) ? logarithm(n) : 0.0;
+        case 2:  return n;
+        case 3:  return (n > 1.0) ? n * logarithm(n) : 0.0;
+        default: return n * n;
+    }
+}
+
+// Least squares coefficient of the real or the cpu time for one class, 0 when it does not apply
+static double fitCoefficient(const UnityBenchmark * bench, int complexity, int cpu)
+{
+    double products = 0.0, squares = 0.0;
+    unsigned int i;
+
+    for (i = 0; i < bench->PointCount; i++)
+    {
+        double f = complexityOf(complexity, (double)bench->Points[i].N);
+
+        products += f * (cpu ? bench->Points[i].CpuNsPerOp : bench->Points[i].NsPerOp);
+        squares += f * f;
+    }
+    return (squares > 0.0) ? products / squares : 0.0;
+}
+
+/* DX_PATCH: the time per iteration of a range is fitted to c * f(N) by least squares for every
+   class f, and the class with the lowest root mean square error wins. The error is reported
+   relative to the mean time, so 0% is a perfect fit. */
+void UnityBench_FitComplexity(UnityBenchmark * bench)
+{
+    double mean = 0.0;
+    int complexity;
+    unsigned int i;
+
+    bench->Complexity = -1;
+    if (bench->PointCount < 2)
+        return;
+    for (i = 0; i < bench->PointCount; i++)
+        mean += bench->Points[i].NsPerOp;
+    mean /= (double)bench->PointCount;
+    if (mean <= 0.0)
+        return;
+
+    for (complexity = 0; complexity < COMPLEXITY_CLASSES; complexity++)
+    {
+        double coefficient = fitCoefficient(bench, complexity, 0);
+        double error = 0.0, rms;
+
+        if (coefficient <= 0.0)
+            continue;
+        for (i = 0; i < bench->PointCount; i++)
+        {
+            double residual = bench->Points[i].NsPerOp - coefficient * complexityOf(complexity, (double)bench->Points[i].N);
+
+            error += residual * residual;
+        }
+        rms = squareRoot(error / (double)bench->PointCount) / mean;
+        if ((bench->Complexity < 0) || (rms < bench->ComplexityRms))
+        {
+            bench->Complexity = complexity;
+            bench->ComplexityCoefficient = coefficient;
+            bench->ComplexityRms = rms;
+        }
+    }
+    if (bench->Complexity >= 0)
+        bench->ComplexityCpuCoefficient = fitCoefficient(bench, bench->Complexity, 1);
+}
+
+// Two sided 95% quantile of Student's t distribution
+static double studentT95(unsigned int degrees)
+{
+    static const double quantiles[] =
+    {
+        12.706, 4.303, 3.182, 2.776, 2.571, 2.447, 2.365, 2.306, 2.262, 2.228,
+        2.201, 2.179, 2.160, 2.145, 2.131, 2.120, 2.110, 2.101, 2.093, 2.086,
+        2.080, 2.074, 2.069, 2.064, 2.060, 2.056, 2.052, 2.048, 2.045, 2.042,
+    };
+
+    if (degrees == 0)
+        return 0.0;
+    return (degrees <= sizeof(quantiles) / sizeof(quantiles[0])) ? quantiles[degrees - 1] : 1.960;
+}
+
+/* DX_PATCH: the ratio of a comparison is the geometric mean of the ratios of its pairs, and its
+   confidence interval comes from the t distribution of their logarithms, so that B taking half
+   the time of A is as far from 1 as B taking twice the time. */
+static void compareRatio(UnityBenchmark * bench)
+{
+    const UnityBenchPoint * a = &bench->Points[0];
+    const UnityBenchPoint * b = &bench->Points[1];
+    double logs[UNITY_BENCH_MAX_SAMPLES];
+    double mean = 0.0, squares = 0.0, halfWidth;
+    unsigned int count = 0;
+    unsigned int i;
+
+    for (i = 0; (i < a->SampleCount) && (i < b->SampleCount); i++)
+    {
+        if ((a->RealNs[i] > 0.0) && (b->RealNs[i] > 0.0))
+        {
+            logs[count] = logarithm(b->RealNs[i] / a->RealNs[i]);
+            mean += logs[count++];
+        }
+    }
+    bench->Ratio = bench->RatioLow = bench->RatioHigh = 0.0;
+    bench->RatioPairs = count;
+    if (count == 0)
+        return;
+    mean /= (double)count;
+    for (i = 0; i < count; i++)
+        squares += (logs[i] - mean) * (logs[i] - mean);
+    halfWidth = (count > 1) ? studentT95(count - 1) * squareRoot(squares / (double)(count - 1) / (double)count) : 0.0;
+    bench->Ratio = exponential(mean);
+    bench->RatioLow = exponential(mean - halfWidth);
+    bench->RatioHigh = exponential(mean + halfWidth);
+}
+
+/* Fails the test unless the whole confidence interval is below the time B is allowed. A single
+   pair has no interval, so it shows nothing either way. */
+static void checkSpeedup(UnityBenchmark * bench)
+{
+    struct _Unity * const unity_p = bench->Unity;
+    char message[256];
+
+    if (bench->MinSpeedup <= 0.0)
+        return;
+    if (bench->RatioPairs < 2)
+    {
+        snprintf(message, sizeof(message), "Expected %s at least %g%% faster than %s. Only %u of the pairs had a measurable time",
+                 bench->Variants[1], bench->MinSpeedup * 100.0, bench->Variants[0], bench->RatioPairs);
+        UnityFail(message, unity_p->CurrentTestLineNumber, unity_p->TestFile, true, unity_p);
+        return;
+    }
+    if (bench->RatioHigh <= 1.0 - bench->MinSpeedup)
+        return;
+    snprintf(message, sizeof(message), "Expected %s at least %g%% faster than %s. Was %.3f times the time [%.3f, %.3f]",
+             bench->Variants[1], bench->MinSpeedup * 100.0, bench->Variants[0],
+             bench->Ratio, bench->RatioLow, bench->RatioHigh);
+    UnityFail(message, unity_p->CurrentTestLineNumber, unity_p->TestFile, true, unity_p);
+}
+
+static void printFixed(double value, struct _Unity * const unity_p)
+{
+    unsigned long long thousandths = (unsigned long long)(value * 1000.0 + 0.5);
+
+    UnityPrintNumberUnsigned((_U_UINT)(thousandths / 1000), unity_p);
+    UNITY_PRINT_CHAR('.', unity_p);
+    UNITY_PRINT_CHAR((char)('0' + (thousandths / 100) % 10), unity_p);
+    UNITY_PRINT_CHAR((char)('0' + (thousandths / 10) % 10), unity_p);
+    UNITY_PRINT_CHAR((char)('0' + thousandths % 10), unity_p);
+}
+
+static void printPoint(const UnityBenchmark * bench, const UnityBenchPoint * point, struct _Unity * const unity_p)
+{
+    printFixed(point->NsPerOp, unity_p);
+    UnityPrint(" ns/op", unity_p);
+    if (bench->RangeMultiplier != 0)
+    {
+        UnityPrint(", ", unity_p);
+        printFixed((point->N > 0) ? point->NsPerOp / (double)point->N : point->NsPerOp, unity_p);
+        UnityPrint(" ns/element", unity_p);
+    }
+    if ((point->BytesPerOp > 0.0) && (point->NsPerOp > 0.0))
+    {
+        UnityPrint(", ", unity_p);
+        printFixed(point->BytesPerOp / point->NsPerOp, unity_p);
+        UnityPrint(" GB/s", unity_p);
+        if (benchTimer.memcpyGbps > 0.0)
+        {
+            UnityPrint(" = ", unity_p);
+            printPercent(point->BytesPerOp / point->NsPerOp / benchTimer.memcpyGbps, unity_p);
+            UnityPrint(" of DRAM memcpy", unity_p);
+        }
+    }
+    if ((point->ItemsPerOp > 0.0) && (point->NsPerOp > 0.0))
+    {
+        UnityPrint(", ", unity_p);
+        printFixed(1000.0 * point->ItemsPerOp / point->NsPerOp, unity_p);
+        UnityPrint(" Mitems/s", unity_p);
+    }
+    UnityPrint(" (min ", unity_p);
+    printFixed(point->MinNsPerOp, unity_p);
+    UnityPrint(", ", unity_p);
+    UnityPrintNumberUnsigned((_U_UINT)point->SampleCount, unity_p);
+    UnityPrint(" x ", unity_p);
+    UnityPrintNumberUnsigned((_U_UINT)point->Iterations, unity_p);
+    UnityPrint(" iterations, cv ", unity_p);
+    printPercent(point->Cv, unity_p);
+    if (point->CacheMode != UNITY_BENCH_HOT)
+    {
+        UnityPrint(", ", unity_p);
+        UnityPrint(cacheModeNames[point->CacheMode], unity_p);
+        if (point->CacheMode == UNITY_BENCH_ROTATE)
+        {
+            UNITY_PRINT_CHAR(' ', unity_p);
+            UnityPrintNumberUnsigned((_U_UINT)point->Copies, unity_p);
+        }
+    }
+    UNITY_PRINT_CHAR(')', unity_p);
+    if (point->Unreliable)
+        UnityPrint(" UNRELIABLE", unity_p);
+#if defined(UNITY_PERF_COUNTERS)
+    {
+        unsigned int i;
+
+        for (i = 0; i < bench->Perf.EventCount; i++)
+        {
+            UnityPrint((i == 0) ? " [" : ", ", unity_p);
+            UnityPrint(bench->Perf.Name[i], unity_p);
+            if (point->CounterValid[i])
+            {
+                UNITY_PRINT_CHAR(' ', unity_p);
+                printFixed(point->CountersPerOp[i], unity_p);
+                UnityPrint("/op", unity_p);
+            }
+            else
+            {
+                UnityPrint(" n/a", unity_p);
+            }
+        }
+        if (bench->Perf.EventCount > 0)
+            UNITY_PRINT_CHAR(']', unity_p);
+    }
+#endif
+}
+
+//--------------------------------------------------------
+//Benchmark environment
+/* DX_PATCH: New feature - --pin-cpu N keeps the whole run on one CPU, so that a benchmark is not
+   migrated halfway; parallel workers inherit the affinity. Before the run a warning is printed
+   when the frequency governor of that CPU is not "performance" or when turbo boost is enabled,
+   since either one makes the clock rate, and so the timings, follow load and temperature. */
+// Trimmed value of "key : value" in a /proc or /sys file, empty when not found
+static void readSystemValue(const char * path, const char * key, char * value, size_t size)
+{
+    char line[256];
+    FILE * file = fopen(path, "r");
+
+    value[0] = '\0';
+    if (file == NULL)
+        return;
+    while (fgets(line, sizeof(line), file) != NULL)
+    {
+        char * start = line;
+        size_t length;
+
+        if (key != NULL)
+        {
+            if ((strncmp(line, key, strlen(key)) != 0) || ((start = strchr(line, ':')) == NULL))
+                continue;
+            start++;
+        }
+        while ((*start == ' ') || (*start == '\t'))
+            start++;
+        length = strcspn(start, "\n");
+        if (length >= size)
+            length = size - 1;
+        memcpy(value, start, length);
+        value[length] = '\0';
+        break;
+    }
+    fclose(file);
 }
 
-static int selected(const char * filter, const char * name)
+// The CPU the run is pinned to, or the first one
+static int benchCpu(const struct _Unity * const unity_p)
 {
-    if (filter == 0)
-        return 1;
-    return strstr(name, filter) ? 1 : 0;
+    return (unity_p->PinCpu >= 0) ? unity_p->PinCpu : 0;
 }
 
-static int testSelected(const char* test, struct _Unity * const unity_p)
+// Nonzero when the governor of the CPU lets its frequency change, which is then copied to governor
+static int frequencyScaling(int cpu, char * governor, size_t size)
 {
-    return selected(unity_p->NameFilter, test);
+    char path[128];
+
+    snprintf(path, sizeof(path), "/sys/devices/system/cpu/cpu%d/cpufreq/scaling_governor", cpu);
+    readSystemValue(path, NULL, governor, size);
+    return (governor[0] != '\0') && (strcmp(governor, "performance") != 0);
 }
 
-static int groupSelected(const char* group, struct _Unity * const unity_p)
+static int turboBoost(void)
 {
-    return selected(unity_p->GroupFilter, group);
+    char value[16];
+
+    readSystemValue("/sys/devices/system/cpu/intel_pstate/no_turbo", NULL, value, sizeof(value));
+    if (value[0] != '\0')
+        return value[0] == '0';
+    readSystemValue("/sys/devices/system/cpu/cpufreq/boost", NULL, value, sizeof(value));
+    return value[0] == '1';
 }
 
-static void runTestCase(struct _Unity * const unity_p)
+static int pinCpu(int cpu)
 {
+    cpu_set_t cpus;
 
+    if ((cpu < 0) || (cpu >= CPU_SETSIZE))
+        return -1;
+    CPU_ZERO(&cpus);
+    CPU_SET(cpu, &cpus);
+    return sched_setaffinity(0, sizeof(cpus), &cpus);
 }
 
-void UnityTestRunner(unityfunction * setup,
-        unityTestfunction * body,
-        unityTestfunction * teardown,
-        const char * printableName,
-        const char * group,
-        const char * name,
-        const char * file, int line, struct _Unity * const unity_p)
+static void checkEnvironment(struct _Unity * const unity_p)
 {
-    if (testSelected(name, unity_p) && groupSelected(group, unity_p))
-    {
-        unity_p->CurrentTestFailed = 0;
-        unity_p->TestFile = file;
-        unity_p->CurrentTestName = printableName;
-        unity_p->CurrentTestLineNumber = line;
-        if (!unity_p->Verbose)
-            UNITY_OUTPUT_CHAR('.');
-        else
-            UnityPrint(printableName, unity_p);
+    char governor[64];
 
-        unity_p->NumberOfTests++;
-#if defined(UNITY_DYNAMIC_MEM_DEBUG)
-        UnityMalloc_StartTest();
-#endif
-#if defined(UNITY_CPP_UNIT_COMPAT)
-        UnityPointer_Init(unity_p);
-#endif 
-        runTestCase(unity_p);
-        /* remember setup has failed - skip teardown if so*/
-        bool hasSetupFailed = false;
-        if (TEST_PROTECT())
-        {
-            setup(unity_p);
-            /*DX_PATCH for jumpless version. If setup failed don't perform the test*/
-            if (!unity_p->CurrentTestFailed) 
-            {
-                body(unity_p->testLocalStorage, unity_p);
-            }
-            else
-            {
-                hasSetupFailed  = true;
-            }
-        }
-        if (TEST_PROTECT() && !hasSetupFailed )
-        {
-            teardown(unity_p->testLocalStorage, unity_p);
-        }
-        if (TEST_PROTECT())
-        {
-#if defined(UNITY_CPP_UNIT_COMPAT)
-            UnityPointer_UndoAllSets(unity_p);
-#endif
-#if defined(UNITY_DYNAMIC_MEM_DEBUG)
-            if (!unity_p->CurrentTestFailed)
-                UnityMalloc_EndTest(unity_p);
-#endif
-        }
-        UnityConcludeFixtureTest(unity_p);
+    if (frequencyScaling(benchCpu(unity_p), governor, sizeof(governor)))
+    {
+        UnityPrint("WARNING: CPU frequency scaling is enabled (governor ", unity_p);
+        UnityPrint(governor, unity_p);
+        UnityPrint("), benchmark timings will be noisy", unity_p);
+        UNITY_PRINT_CHAR('\n', unity_p);
+    }
+    if (turboBoost())
+    {
+        UnityPrint("WARNING: turbo boost is enabled, benchmark timings will be noisy", unity_p);
+        UNITY_PRINT_CHAR('\n', unity_p);
     }
 }
 
-void UnityIgnoreTest(const char * printableName, struct _Unity * const unity_p)
+//--------------------------------------------------------
+//Benchmark output
+/* DX_PATCH: New feature - --benchmark-out file.json writes every benchmark in the JSON format of
+   Google Benchmark, so its compare.py and similar tools can diff two runs. Each sample is an
+   "iteration" record, followed by its mean, median, stddev and cv aggregates, and a range adds the
+   BigO and RMS records of its fit. Benchmarks of parallel workers append to the same file. */
+struct _UnityBenchOutput
 {
-    unity_p->NumberOfTests++;
-    unity_p->CurrentTestIgnored = 1;
-    if (!unity_p->Verbose)
-        UNITY_OUTPUT_CHAR('!');
-    else
-        UnityPrint(printableName, unity_p);
-    UnityConcludeFixtureTest(unity_p);
-}
+    FILE * file;
+    unsigned long records;
+    FILE * tests;                   // records of the plain tests, copied in after the benchmarks
+    unsigned long testRecords;
+    int lock;
+};
 
-#if defined(UNITY_DYNAMIC_MEM_DEBUG)
-//-------------------------------------------------
-//Malloc and free stuff
-//
-#define MALLOC_DONT_FAIL -1
-static int malloc_count;
-static int malloc_fail_countdown = MALLOC_DONT_FAIL;
+static void lockOutput(struct _UnityBenchOutput * output)
+{
+    while (__atomic_exchange_n(&output->lock, 1, __ATOMIC_ACQUIRE))
+        ;
+}
 
-void UnityMalloc_StartTest(void)
+static void unlockOutput(struct _UnityBenchOutput * output)
 {
-    malloc_count = 0;
-    malloc_fail_countdown = MALLOC_DONT_FAIL;
+    __atomic_store_n(&output->lock, 0, __ATOMIC_RELEASE);
 }
 
-void UnityMalloc_EndTest( struct _Unity * const unity_p )
+static void writeJsonString(FILE * file, const char * text)
 {
-    malloc_fail_countdown = MALLOC_DONT_FAIL;
-    if (malloc_count != 0)
+    fputc('"', file);
+    for (; *text != '\0'; text++)
     {
-        TEST_FAIL_MESSAGE("This test leaks!");
+        unsigned char c = (unsigned char)*text;
+
+        if ((c == '"') || (c == '\\'))
+            fprintf(file, "\\%c", c);
+        else if (c < 0x20)
+            fprintf(file, "\\u%04x", c);
+        else
+            fputc(c, file);
     }
+    fputc('"', file);
 }
 
-void UnityMalloc_MakeMallocFailAfterCount(int countdown)
+#ifndef UNITY_BENCH_COMPILER_FLAGS
+#define UNITY_BENCH_COMPILER_FLAGS ""
+#endif
+
+static void writeContext(FILE * file, const char * executable, const struct _Unity * const unity_p)
 {
-    malloc_fail_countdown = countdown;
-}
+    char text[256];
+    char path[128];
+    double mhz = 0.0;
+    double load[3] = { 0.0, 0.0, 0.0 };
+    time_t now = time(NULL);
+    int loads, i;
 
-#ifdef malloc
-#undef malloc
-#endif
+    strftime(text, sizeof(text), "%Y-%m-%dT%H:%M:%S%z", localtime(&now));
+    fprintf(file, "{\n  \"context\": {\n    \"date\": ");
+    writeJsonString(file, text);
+    if (gethostname(text, sizeof(text)) != 0)
+        text[0] = '\0';
+    text[sizeof(text) - 1] = '\0';
+    fprintf(file, ",\n    \"host_name\": ");
+    writeJsonString(file, text);
+    fprintf(file, ",\n    \"executable\": ");
+    writeJsonString(file, executable);
+    fprintf(file, ",\n    \"num_cpus\": %ld", sysconf(_SC_NPROCESSORS_ONLN));
 
-#ifdef free
-#undef free
-#endif
+    snprintf(path, sizeof(path), "/sys/devices/system/cpu/cpu%d/cpufreq/cpuinfo_max_freq", benchCpu(unity_p));
+    readSystemValue(path, NULL, text, sizeof(text));
+    if (text[0] != '\0')
+        mhz = strtod(text, NULL) / 1000.0;
+    else
+    {
+        readSystemValue("/proc/cpuinfo", "cpu MHz", text, sizeof(text));
+        mhz = strtod(text, NULL);
+    }
+    fprintf(file, ",\n    \"mhz_per_cpu\": %.0f", mhz);
+    fprintf(file, ",\n    \"cpu_scaling_enabled\": %s", frequencyScaling(benchCpu(unity_p), text, sizeof(text)) ? "true" : "false");
+    fprintf(file, ",\n    \"turbo_enabled\": %s", turboBoost() ? "true" : "false");
+    fprintf(file, ",\n    \"pinned_cpu\": %d", unity_p->PinCpu);
+    fprintf(file, ",\n    \"max_cv\": %g", unity_p->BenchMaxCv);
+    fprintf(file, ",\n    \"cache_mode\": \"%s\"", cacheModeNames[unity_p->BenchCacheMode]);
+    readSystemValue("/proc/cpuinfo", "model name", text, sizeof(text));
+    fprintf(file, ",\n    \"cpu_model\": ");
+    writeJsonString(file, text);
 
-#include <stdlib.h>
-#include <string.h>
+    loads = getloadavg(load, 3);
+    fprintf(file, ",\n    \"load_avg\": [");
+    for (i = 0; i < loads; i++)
+        fprintf(file, "%s%g", (i == 0) ? "" : ", ", load[i]);
+    fprintf(file, "],\n    \"timer\": ");
+    writeJsonString(file, benchTimer.name);
+    fprintf(file, ",\n    \"dram_memcpy_gbps\": %.4g,\n    \"dram_memset_gbps\": %.4g", benchTimer.memcpyGbps, benchTimer.memsetGbps);
+    fprintf(file, ",\n    \"compiler\": ");
+#if defined(__VERSION__)
+    writeJsonString(file, __VERSION__);
+#else
+    writeJsonString(file, "");
+#endif
+    fprintf(file, ",\n    \"compiler_flags\": ");
+    writeJsonString(file, UNITY_BENCH_COMPILER_FLAGS);
+#if defined(__OPTIMIZE__) && defined(NDEBUG)
+    fprintf(file, ",\n    \"library_build_type\": \"release\"");
+#else
+    fprintf(file, ",\n    \"library_build_type\": \"debug\"");
+#endif
+    fprintf(file, "\n  },\n  \"benchmarks\": [");
+}
 
-typedef struct GuardBytes
+// Pins the run, checks the CPU and opens --benchmark-out, nonzero when one of them failed
+int UnityBench_Begin(int argc, char* argv[], struct _Unity * const unity_p)
 {
-    size_t size;
-    char guard[sizeof(size_t)];
-} Guard;
+    struct _UnityBenchOutput * output;
 
+    unity_p->BenchOutput = NULL;
+    if ((unity_p->PinCpu >= 0) && (pinCpu(unity_p->PinCpu) != 0))
+    {
+        UnityPrint("Cannot pin the run to CPU ", unity_p);
+        UnityPrintNumber(unity_p->PinCpu, unity_p);
+        UNITY_PRINT_CHAR('\n', unity_p);
+        return 1;
+    }
+    checkEnvironment(unity_p);
+    if (unity_p->BenchmarkOut == NULL)
+        return 0;
+    output = (struct _UnityBenchOutput *)UNITY_INTERNAL_CALLOC(1, sizeof(*output));
+    if ((output == NULL) || ((output->file = fopen(unity_p->BenchmarkOut, "w")) == NULL))
+    {
+        UNITY_INTERNAL_FREE(output);
+        UnityPrint("Cannot write benchmark results to ", unity_p);
+        UnityPrint(unity_p->BenchmarkOut, unity_p);
+        UNITY_PRINT_CHAR('\n', unity_p);
+        return 1;
+    }
+    // the context names the timer, so calibrate before writing it
+    benchTimerInit();
+    writeContext(output->file, (argc > 0) ? argv[0] : "", unity_p);
+    unity_p->BenchOutput = output;
+    return 0;
+}
 
-static const char * end = "END";
-
-void * unity_malloc(size_t size)
+void UnityBench_End(struct _Unity * const unity_p)
 {
-    char* mem;
-    Guard* guard;
+    struct _UnityBenchOutput * output = unity_p->BenchOutput;
 
-    if (malloc_fail_countdown != MALLOC_DONT_FAIL)
+    // the sweep buffer goes with the calibration, a later run makes both again
+    if (__atomic_load_n(&benchTimerState, __ATOMIC_ACQUIRE) == 2)
     {
-        if (malloc_fail_countdown == 0)
-            return 0;
-        malloc_fail_countdown--;
+        UNITY_INTERNAL_FREE(benchTimer.sweep);
+        benchTimer.sweep = NULL;
+        __atomic_store_n(&benchTimerState, 0, __ATOMIC_RELEASE);
     }
+    if (output == NULL)
+        return;
+    fprintf(output->file, "\n  ]");
+    if (output->tests != NULL)
+    {
+        int c;
 
-    malloc_count++;
+        fprintf(output->file, ",\n  \"tests\": [");
+        rewind(output->tests);
+        while ((c = fgetc(output->tests)) != EOF)
+            fputc(c, output->file);
+        fprintf(output->file, "\n  ]");
+        fclose(output->tests);
+    }
+    fprintf(output->file, "\n}\n");
+    fclose(output->file);
+    UNITY_INTERNAL_FREE(output);
+    unity_p->BenchOutput = NULL;
+}
 
-    guard = (Guard*)malloc(size + sizeof(Guard) + 4);
-    assert(guard);
-    guard->size = size;
-    mem = (char*)&(guard[1]);
-    memcpy(&mem[size], end, strlen(end) + 1);
+#if defined(UNITY_PERF_COUNTERS)
+/* The counter deltas of a plain test go to a "tests" array of their own, Google Benchmark's tools
+   would take a record without times in "benchmarks" for a broken benchmark. Tests finish in any
+   order under -j, so they are kept in a temporary file until the benchmarks are closed. */
+void UnityBench_WriteTestCounters(struct _Unity * const unity_p)
+{
+    struct _UnityBenchOutput * output = unity_p->BenchOutput;
+    const struct _UnityPerfCounters * perf = &unity_p->Perf;
+    unsigned int i;
 
-    return (void*)mem;
+    if ((output == NULL) || (perf->EventCount == 0))
+        return;
+    lockOutput(output);
+    if (output->tests == NULL)
+        output->tests = tmpfile();
+    if (output->tests != NULL)
+    {
+        fprintf(output->tests, "%s\n    {\n      \"name\": ", (output->testRecords++ == 0) ? "" : ",");
+        writeJsonString(output->tests, unity_p->CurrentTestName);
+        fprintf(output->tests, ",\n      \"failed\": %s", unity_p->CurrentTestFailed ? "true" : "false");
+        for (i = 0; i < perf->EventCount; i++)
+        {
+            if (perf->Valid[i])
+                fprintf(output->tests, ",\n      \"%s\": %llu", perf->Name[i], perf->Value[i]);
+        }
+        fprintf(output->tests, "\n    }");
+    }
+    unlockOutput(output);
 }
+#endif
 
-static int isOverrun(void * mem)
+// Opens a record with the fields every record has, the caller adds the rest and closes it
+static void beginRecord(struct _UnityBenchOutput * output, const char * runName, const char * suffix, const char * runType)
 {
-    Guard* guard = (Guard*)mem;
-    char* memAsChar = (char*)mem;
-    guard--;
+    char name[512];
 
-    return strcmp(&memAsChar[guard->size], end) != 0;
+    snprintf(name, sizeof(name), "%s%s", runName, suffix);
+    fprintf(output->file, "%s\n    {\n      \"name\": ", (output->records++ == 0) ? "" : ",");
+    writeJsonString(output->file, name);
+    fprintf(output->file, ",\n      \"run_name\": ");
+    writeJsonString(output->file, runName);
+    fprintf(output->file, ",\n      \"run_type\": \"%s\"", runType);
 }
 
-static void release_memory(void * mem)
+static void writeTimes(FILE * file, unsigned long iterations, double realNs, double cpuNs)
 {
-    Guard* guard = (Guard*)mem;
-    guard--;
+    fprintf(file, ",\n      \"iterations\": %lu,\n      \"real_time\": %.9g,\n      \"cpu_time\": %.9g,\n      \"time_unit\": \"ns\"",
+            iterations, realNs, cpuNs);
+}
 
-    malloc_count--;
-    free(guard);
+// Google Benchmark's own throughput counters, per second of real time
+static void writeThroughput(FILE * file, const UnityBenchPoint * point, double realNs)
+{
+    if (realNs <= 0.0)
+        return;
+    if (point->BytesPerOp > 0.0)
+        fprintf(file, ",\n      \"bytes_per_second\": %.9g", point->BytesPerOp * 1e9 / realNs);
+    if (point->ItemsPerOp > 0.0)
+        fprintf(file, ",\n      \"items_per_second\": %.9g", point->ItemsPerOp * 1e9 / realNs);
 }
 
-void unity_free(void * mem)
+// The cache mode, and whether the samples never settled
+static void writeLabel(FILE * file, const UnityBenchPoint * point)
 {
-    int overrun = isOverrun(mem);//strcmp(&memAsChar[guard->size], end) != 0;
-    release_memory(mem);
-    if (overrun)
-    {
-        TEST_FAIL_MESSAGE("Buffer overrun detected during free()");
-    }
+    fprintf(file, ",\n      \"label\": \"cache %s", cacheModeNames[point->CacheMode]);
+    if (point->CacheMode == UNITY_BENCH_ROTATE)
+        fprintf(file, " %u", point->Copies);
+    fprintf(file, "%s\",\n      \"cache_mode\": \"%s\"", point->Unreliable ? ", unreliable" : "", cacheModeNames[point->CacheMode]);
 }
 
-void* unity_calloc(size_t num, size_t size)
+static void writeCounters(FILE * file, const UnityBenchmark * bench, const UnityBenchPoint * point)
 {
-    void* mem = unity_malloc(num * size);
-    memset(mem, 0, num*size);
-    return mem;
+#if defined(UNITY_PERF_COUNTERS)
+    unsigned int i;
+
+    for (i = 0; i < bench->Perf.EventCount; i++)
+    {
+        if (point->CounterValid[i])
+            fprintf(file, ",\n      \"%s\": %.9g", bench->Perf.Name[i], point->CountersPerOp[i]);
+    }
+#else
+    (void)file;
+    (void)bench;
+    (void)point;
+#endif
 }
 
-void* unity_realloc(void * oldMem, size_t size)
+static void writePoint(struct _UnityBenchOutput * output, const UnityBenchmark * bench, const UnityBenchPoint * point)
 {
-    Guard* guard = (Guard*)oldMem;
-//    char* memAsChar = (char*)oldMem;
-    void* newMem;
+    static const char * const aggregates[] = { "mean", "median", "stddev", "cv" };
+    FILE * file = output->file;
+    char runName[256];
+    double meanReal = 0.0, meanCpu = 0.0, squaresReal = 0.0, squaresCpu = 0.0;
+    unsigned int i, count = point->SampleCount;
 
-    if (oldMem == 0)
-        return unity_malloc(size);
+    if (bench->Variants[0] != NULL)
+        snprintf(runName, sizeof(runName), "%s/%s", bench->Name, bench->Variants[point - bench->Points]);
+    else if (bench->RangeMultiplier != 0)
+        snprintf(runName, sizeof(runName), "%s/%lu", bench->Name, point->N);
+    else
+        snprintf(runName, sizeof(runName), "%s", bench->Name);
 
-    guard--;
-    if (isOverrun(oldMem))
+    for (i = 0; i < count; i++)
     {
-        release_memory(oldMem);
-        /*DX_PATCH for jumless version*/
-        UnityPrint("Buffer overrun detected during realloc()", unity_p);
-        return 0;
+        beginRecord(output, runName, "", "iteration");
+        fprintf(file, ",\n      \"repetitions\": %u,\n      \"repetition_index\": %u,\n      \"threads\": 1", count, i);
+        writeTimes(file, point->Iterations, point->RealNs[i], point->CpuNs[i]);
+        writeThroughput(file, point, point->RealNs[i]);
+        writeLabel(file, point);
+        writeCounters(file, bench, point);
+        fprintf(file, "\n    }");
+        meanReal += point->RealNs[i];
+        meanCpu += point->CpuNs[i];
     }
-
-    if (size == 0)
+    meanReal /= (double)count;
+    meanCpu /= (double)count;
+    for (i = 0; i < count; i++)
     {
-        release_memory(oldMem);
-        return 0;
+        squaresReal += (point->RealNs[i] - meanReal) * (point->RealNs[i] - meanReal);
+        squaresCpu += (point->CpuNs[i] - meanCpu) * (point->CpuNs[i] - meanCpu);
     }
 
-    if (guard->size >= size)
-        return oldMem;
+    for (i = 0; i < sizeof(aggregates) / sizeof(aggregates[0]); i++)
+    {
+        char suffix[16];
+        double real = meanReal, cpu = meanCpu;
 
-    newMem = unity_malloc(size);
-    memcpy(newMem, oldMem, guard->size);
-    unity_free(oldMem);
-    return newMem;
+        if (i == 1)
+        {
+            real = point->NsPerOp;
+            cpu = point->CpuNsPerOp;
+        }
+        else if (i >= 2)
+        {
+            real = (count > 1) ? squareRoot(squaresReal / (double)(count - 1)) : 0.0;
+            cpu = (count > 1) ? squareRoot(squaresCpu / (double)(count - 1)) : 0.0;
+            if (i == 3)
+            {
+                real = (meanReal > 0.0) ? real / meanReal : 0.0;
+                cpu = (meanCpu > 0.0) ? cpu / meanCpu : 0.0;
+            }
+        }
+        snprintf(suffix, sizeof(suffix), "_%s", aggregates[i]);
+        beginRecord(output, runName, suffix, "aggregate");
+        fprintf(file, ",\n      \"repetitions\": %u,\n      \"threads\": 1,\n      \"aggregate_name\": \"%s\"", count, aggregates[i]);
+        if (i == 3)
+            fprintf(file, ",\n      \"aggregate_unit\": \"percentage\"");
+        writeTimes(file, point->Iterations, real, cpu);
+        writeLabel(file, point);
+        if (i < 2)
+        {
+            writeThroughput(file, point, real);
+            writeCounters(file, bench, point);
+        }
+        fprintf(file, "\n    }");
+    }
 }
 
-#endif /* UNITY_DYNAMIC_MEM_DEBUG */
-
-#if defined(UNITY_CPP_UNIT_COMPAT)
-
-//--------------------------------------------------------
-//Automatic pointer restoration functions
-typedef struct _PointerPair
+static void writeBenchmark(struct _UnityBenchOutput * output, const UnityBenchmark * bench)
 {
-    struct _PointerPair * next;
-    void ** pointer;
-    void * old_value;
-} PointerPair;
+    FILE * file = output->file;
+    unsigned int i;
 
-enum {MAX_POINTERS=50};
-static PointerPair pointer_store[MAX_POINTERS];
-static int pointer_index = 0;
-
-void UnityPointer_Init( struct _Unity * const unity_p )
-{
-    pointer_index = 0;
+    lockOutput(output);
+    for (i = 0; i < bench->PointCount; i++)
+        writePoint(output, bench, &bench->Points[i]);
+    if (bench->Complexity >= 0)
+    {
+        beginRecord(output, bench->Name, "_BigO", "aggregate");
+        fprintf(file, ",\n      \"aggregate_name\": \"BigO\",\n      \"cpu_coefficient\": %.9g,\n      \"real_coefficient\": %.9g,"
+                      "\n      \"big_o\": \"%s\",\n      \"time_unit\": \"ns\"\n    }",
+                bench->ComplexityCpuCoefficient, bench->ComplexityCoefficient, complexityBigO[bench->Complexity]);
+        beginRecord(output, bench->Name, "_RMS", "aggregate");
+        fprintf(file, ",\n      \"aggregate_name\": \"RMS\",\n      \"rms\": %.9g\n    }", bench->ComplexityRms);
+    }
+    if (bench->Variants[0] != NULL)
+    {
+        beginRecord(output, bench->Name, "_ratio", "aggregate");
+        fprintf(file, ",\n      \"aggregate_name\": \"ratio\",\n      \"baseline\": ");
+        writeJsonString(file, bench->Variants[0]);
+        fprintf(file, ",\n      \"contender\": ");
+        writeJsonString(file, bench->Variants[1]);
+        fprintf(file, ",\n      \"ratio\": %.9g,\n      \"ratio_low\": %.9g,\n      \"ratio_high\": %.9g\n    }",
+                bench->Ratio, bench->RatioLow, bench->RatioHigh);
+    }
+    fflush(file);
+    unlockOutput(output);
 }
 
-void UnityPointer_Set(void ** ptr, void * newValue, struct _Unity * const unity_p)
+// Printed after the test name in verbose mode, a range gets a line for every N and then its fit,
+// a comparison a line for each implementation and then their ratio
+void UnityBench_Report(UnityBenchmark * bench)
 {
-    if (pointer_index >= MAX_POINTERS)
-        TEST_FAIL_MESSAGE("Too many pointers set");
+    struct _Unity * const unity_p = bench->Unity;
+    unsigned int i;
 
-    pointer_store[pointer_index].pointer = ptr;
-    pointer_store[pointer_index].old_value = *ptr;
-    *ptr = newValue;
-    pointer_index++;
-}
+    freeCopies(bench);
+    if (unity_p->CurrentTestFailed || (bench->PointCount == 0))
+        return;
+    if (bench->RangeMultiplier != 0)
+        UnityBench_FitComplexity(bench);
+    if (bench->Variants[0] != NULL)
+        compareRatio(bench);
+    if (unity_p->BenchOutput != NULL)
+        writeBenchmark(unity_p->BenchOutput, bench);
+    if (bench->Variants[0] != NULL)
+        checkSpeedup(bench);
+    if (!unity_p->Verbose || unity_p->CurrentTestFailed)
+        return;
 
-void UnityPointer_UndoAllSets( struct _Unity * const unity_p )
-{
-    while (pointer_index > 0)
+    if (bench->Variants[0] != NULL)
     {
-        pointer_index--;
-        *(pointer_store[pointer_index].pointer) =
-        pointer_store[pointer_index].old_value;
-
+        for (i = 0; i < 2; i++)
+        {
+            UNITY_PRINT_CHAR('\n', unity_p);
+            UnityPrint("  ", unity_p);
+            UnityPrint(bench->Variants[i], unity_p);
+            UnityPrint(": ", unity_p);
+            printPoint(bench, &bench->Points[i], unity_p);
+        }
+        UNITY_PRINT_CHAR('\n', unity_p);
+        UnityPrint("  ", unity_p);
+        UnityPrint(bench->Variants[1], unity_p);
+        UnityPrint(" / ", unity_p);
+        UnityPrint(bench->Variants[0], unity_p);
+        UnityPrint(" = ", unity_p);
+        printFixed(bench->Ratio, unity_p);
+        UnityPrint(" [", unity_p);
+        printFixed(bench->RatioLow, unity_p);
+        UnityPrint(", ", unity_p);
+        printFixed(bench->RatioHigh, unity_p);
+        UNITY_PRINT_CHAR(']', unity_p);
+    }
+    else if (bench->RangeMultiplier == 0)
+    {
+        UNITY_PRINT_CHAR(' ', unity_p);
+        printPoint(bench, &bench->Points[0], unity_p);
+    }
+    else
+    {
+        for (i = 0; i < bench->PointCount; i++)
+        {
+            UNITY_PRINT_CHAR('\n', unity_p);
+            UnityPrint("  n ", unity_p);
+            UnityPrintNumberUnsigned((_U_UINT)bench->Points[i].N, unity_p);
+            UnityPrint(": ", unity_p);
+            printPoint(bench, &bench->Points[i], unity_p);
+        }
+        UNITY_PRINT_CHAR('\n', unity_p);
+        UnityPrint("  ", unity_p);
+        if (bench->Complexity >= 0)
+        {
+            UnityPrint(complexityNames[bench->Complexity], unity_p);
+            UnityPrint(", RMS ", unity_p);
+            printPercent(bench->ComplexityRms, unity_p);
+        }
+        else
+        {
+            UnityPrint("no fit", unity_p);
+        }
     }
+    UnityPrint(" (", unity_p);
+    UnityPrint(benchTimer.name, unity_p);
+    UNITY_PRINT_CHAR(')', unity_p);
 }
+#endif /* UNITY_BENCHMARK */
 
-#endif
 int UnityFailureCount( struct _Unity * const unity_p )
 {
     return unity_p->TestFailures;
@@ -341,6 +3332,23 @@ int UnityGetCommandLineOptions(int argc, char* argv[], struct _Unity * const uni
     unity_p->GroupFilter = 0;
     unity_p->NameFilter = 0;
     unity_p->RepeatCount = 1;
+    unity_p->RepeatTestCount = 0;
+    unity_p->UntilFail = 0;
+    unity_p->Jobs = 1;
+    unity_p->OrderedOutput = 0;
+    unity_p->Parallel = NULL;
+    unity_p->ReportAllMismatches = 0;
+    unity_p->UpdateGolden = 0;
+    unity_p->RecordDigests = 0;
+    unity_p->AllocSweep = 0;
+    unity_p->BenchmarkOut = NULL;
+    unity_p->PinCpu = -1;
+    unity_p->BenchMaxCv = UNITY_BENCH_MAX_CV;
+    unity_p->BenchCacheMode = 0;
+    unity_p->BenchRotateCopies = 0;
+#if defined(UNITY_PERF_COUNTERS)
+    unity_p->Perf.EventCount = 0;
+#endif
 
     if (argc == 1)
         return 0;
@@ -380,11 +3388,104 @@ int UnityGetCommandLineOptions(int argc, char* argv[], struct _Unity * const uni
                     i++;
                 }
             }
+        }
+        else if (strcmp(argv[i], "--repeat-test") == 0)
+        {
+            i++;
+            if (i >= argc)
+                return 1;
+            unity_p->RepeatTestCount = strtoul(argv[i], NULL, 10);
+            i++;
+        }
+        else if (strcmp(argv[i], "--until-fail") == 0)
+        {
+            unity_p->UntilFail = 1;
+            i++;
+        }
+        else if (strcmp(argv[i], "--ordered-output") == 0)
+        {
+            unity_p->OrderedOutput = 1;
+            i++;
+        }
+        else if (strcmp(argv[i], "--all-mismatches") == 0)
+        {
+            unity_p->ReportAllMismatches = 1;
+            i++;
+        }
+        else if (strcmp(argv[i], "--update-golden") == 0)
+        {
+            unity_p->UpdateGolden = 1;
+            i++;
+        }
+        else if (strcmp(argv[i], "--record-digests") == 0)
+        {
+            unity_p->RecordDigests = 1;
+            i++;
+        }
+        else if (strcmp(argv[i], "--alloc-sweep") == 0)
+        {
+            unity_p->AllocSweep = 1;
+            i++;
+        }
+#if defined(UNITY_BENCHMARK)
+        else if (strcmp(argv[i], "--benchmark-out") == 0)
+        {
+            i++;
+            if (i >= argc)
+                return 1;
+            unity_p->BenchmarkOut = argv[i];
+            i++;
+        }
+        else if (strcmp(argv[i], "--pin-cpu") == 0)
+        {
+            i++;
+            if ((i >= argc) || (*(argv[i]) < '0') || (*(argv[i]) > '9'))
+                return 1;
+            unity_p->PinCpu = atoi(argv[i]);
+            i++;
+        }
+        else if (strcmp(argv[i], "--cache-mode") == 0)
+        {
+            i++;
+            if ((i >= argc) || (UnityBench_SelectCacheMode(argv[i], unity_p) != 0))
+                return 1;
+            i++;
+        }
+        else if (strcmp(argv[i], "--max-cv") == 0)
+        {
+            i++;
+            if (i >= argc)
+                return 1;
+            unity_p->BenchMaxCv = strtod(argv[i], NULL) / 100.0;
+            i++;
+        }
+#endif
+#if defined(UNITY_PERF_COUNTERS)
+        else if (strcmp(argv[i], "--perf-counters") == 0)
+        {
+            i++;
+            if ((i >= argc) || (UnityPerf_Select(argv[i], unity_p) != 0))
+                return 1;
+            i++;
+        }
+#endif
+        else if (strcmp(argv[i], "-j") == 0)
+        {
+            i++;
+            if (i >= argc)
+                return 1;
+            unity_p->Jobs = (unsigned int)atoi(argv[i]);
+            i++;
         } else {
             // ignore unknown parameter
             i++;
         }
     }
+#if defined(UNITY_BENCHMARK)
+    // the workers would all inherit the one CPU and queue behind each other on it
+    if ((unity_p->PinCpu >= 0) && (unity_p->Jobs > 1))
+        return 1;
+#endif
     return 0;
 }
 
@@ -394,7 +3495,7 @@ void UnityConcludeFixtureTest( struct _Unity * const unity_p )
     {
         if (unity_p->Verbose)
         {
-            UNITY_OUTPUT_CHAR('\n');
+            UNITY_PRINT_CHAR('\n', unity_p);
         }
         unity_p->TestIgnores++;
     }
@@ -402,8 +3503,14 @@ void UnityConcludeFixtureTest( struct _Unity * const unity_p )
     {
         if (unity_p->Verbose)
         {
+#if defined(UNITY_DYNAMIC_MEM_DEBUG)
+            UnityMalloc_PrintStats(unity_p);
+#endif
+#if defined(UNITY_PERF_COUNTERS)
+            UnityPerf_Print(unity_p);
+#endif
             UnityPrint(" PASS", unity_p);
-            UNITY_OUTPUT_CHAR('\n');
+            UNITY_PRINT_CHAR('\n', unity_p);
         }
     }
     else if (unity_p->CurrentTestFailed)
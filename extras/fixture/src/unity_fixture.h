@@ -13,7 +13,7 @@
 /* DX_PATCH: Removing malloc overrides - it cannot be used with stdlib.h included
    before or after, as documented in https://github.com/ThrowTheSwitch/Unity/issues/24,
    which is a too severe limitation for practical use. */
-#if defined(UNITY_DYNAMIC_MEM_DEBUG)
+#if defined(UNITY_DYNAMIC_MEM_DEBUG) && !defined(UNITY_WRAP_MALLOC)
 #include "unity_fixture_malloc_overrides.h"
 #endif /* UNITY_DYNAMIC_MEM_DEBUG */
 
@@ -97,9 +97,113 @@ int UnityMain(int argc, char* argv[], void (*runAllTests)(struct _Unity * const
     { void TEST_##group##_GROUP_RUNNER(struct _Unity * const unity_p);\
       TEST_##group##_GROUP_RUNNER(unity_p); }
 
+/* DX_PATCH: golden file assertions, the reference file is rewritten when run with --update-golden */
+#if defined(UNITY_GOLDEN_FILES)
+#define TEST_ASSERT_MATCHES_GOLDEN_FILE(path, actual, len) \
+    if (UnityAssertMatchesGoldenFile((path), (actual), (size_t)(len), NULL, (UNITY_LINE_TYPE)__LINE__, __FILE__, unity_p) != 0) return;
+#define TEST_ASSERT_MATCHES_GOLDEN_FILE_MESSAGE(path, actual, len, message) \
+    if (UnityAssertMatchesGoldenFile((path), (actual), (size_t)(len), (message), (UNITY_LINE_TYPE)__LINE__, __FILE__, unity_p) != 0) return;
+#endif /* UNITY_GOLDEN_FILES */
+
+/* DX_PATCH: benchmarks. The body of a TEST_BENCHMARK runs once per batch, and only the statement
+   after UNITY_BENCH_LOOP is timed, repeated as many times as the batch asks for:
+
+       TEST_BENCHMARK(group, name)
+       {
+           prepare();
+           UNITY_BENCH_LOOP
+           {
+               UNITY_BENCH_DO_NOT_OPTIMIZE(work());
+           }
+       }
+*/
+#if defined(UNITY_BENCHMARK)
+#define TEST_BENCHMARK(group, name) \
+    UNITY_BENCHMARK_TEST(group, name, 0, 0, 0)
+
+/* DX_PATCH: runs the body for N = lo, lo * mult, ... and at last hi itself, read as UNITY_BENCH_N,
+   and fits the time per iteration to O(1), O(log n), O(n), O(n log n) or O(n^2) */
+#define TEST_BENCHMARK_RANGE(group, name, lo, hi, mult) \
+    UNITY_BENCHMARK_TEST(group, name, (lo), (hi), (mult))
+
+#define UNITY_BENCHMARK_TEST(group, name, lo, hi, mult) \
+    static void BENCH_##group##_##name##_(UnityBenchmark * const bench, Test_##group##_Data * const _td, struct _Unity * const unity_p);\
+    TEST(group, name)\
+    {\
+        UnityBenchmark bench;\
+        UnityBench_Init(&bench, #group "." #name, unity_p);\
+        if ((mult) != 0)\
+            UnityBench_SetRange(&bench, (unsigned long)(lo), (unsigned long)(hi), (unsigned long)(mult));\
+        do\
+        {\
+            BENCH_##group##_##name##_(&bench, _td, unity_p);\
+        } while (UnityBench_Next(&bench));\
+        UnityBench_Report(&bench);\
+    }\
+    static void BENCH_##group##_##name##_(UnityBenchmark * const bench, Test_##group##_Data * const _td, struct _Unity * const unity_p)
+
+/* DX_PATCH: times two implementations with the same body, which calls the one of the current batch
+   as UNITY_BENCH_IMPL. Batches of A and B alternate in random order, and the ratio of their times
+   is reported with a 95% confidence interval. The _THRESHOLD form fails unless B is, with that
+   confidence, at least percent faster than A. */
+#define TEST_BENCHMARK_COMPARE(group, name, implA, implB) \
+    UNITY_BENCHMARK_COMPARE_TEST(group, name, implA, implB, 0)
+
+#define TEST_BENCHMARK_COMPARE_THRESHOLD(group, name, implA, implB, percent) \
+    UNITY_BENCHMARK_COMPARE_TEST(group, name, implA, implB, (percent))
+
+#define UNITY_BENCHMARK_COMPARE_TEST(group, name, implA, implB, percent) \
+    static void BENCH_##group##_##name##_(UnityBenchmark * const bench, __typeof__(&(implA)) const unity_impl, Test_##group##_Data * const _td, struct _Unity * const unity_p);\
+    TEST(group, name)\
+    {\
+        UnityBenchmark bench;\
+        UnityBench_Init(&bench, #group "." #name, unity_p);\
+        UnityBench_SetCompare(&bench, #implA, #implB, (double)(percent));\
+        do\
+        {\
+            BENCH_##group##_##name##_(&bench, bench.Variant ? (implB) : (implA), _td, unity_p);\
+        } while (UnityBench_Next(&bench));\
+        UnityBench_Report(&bench);\
+    }\
+    static void BENCH_##group##_##name##_(UnityBenchmark * const bench, __typeof__(&(implA)) const unity_impl, Test_##group##_Data * const _td, struct _Unity * const unity_p)
+
+/* DX_PATCH: what one iteration of UNITY_BENCH_LOOP processes, reported as GB/s and Mitems/s and,
+   for bytes, as a share of the DRAM memcpy bandwidth of the machine */
+#define UNITY_BENCH_SET_BYTES(n)    (bench->BytesPerOp = (double)(n))
+#define UNITY_BENCH_SET_ITEMS(n)    (bench->ItemsPerOp = (double)(n))
+
+/* DX_PATCH: cache state before every iteration, UNITY_BENCH_HOT, _COLD, _FLUSH or _ROTATE through
+   copies copies of the input (0 for as many as fill UNITY_BENCH_REFERENCE_BYTES). The body names
+   its input with UNITY_BENCH_INPUT(pointer, bytes); in rotate mode the pointer variable is moved to
+   another copy before each iteration, so the loop has to read the input through it. The time spent
+   on the caches is not counted. */
+#define UNITY_BENCH_SET_CACHE(mode, copies) \
+    (bench->CacheMode = (mode), bench->Copies = (unsigned int)(copies))
+#define UNITY_BENCH_INPUT(pointer, bytes) \
+    UnityBench_SetInput(bench, (void *)&(pointer), (size_t)(bytes))
+
+#define UNITY_BENCH_IMPL    unity_impl
+#define UNITY_BENCH_N       (bench->N)
+#define UNITY_BENCH_LOOP \
+    for (unsigned long _unity_n = UnityBench_Start(bench); \
+         (_unity_n > 0) ? ((bench->CacheMode == UNITY_BENCH_HOT) || UnityBench_Prepare(bench)) : UnityBench_Stop(bench); \
+         _unity_n--)
+
+#define UNITY_BENCH_DO_NOT_OPTIMIZE(value)  __asm__ volatile("" : : "g"(value) : "memory")
+#define UNITY_BENCH_CLOBBER()               __asm__ volatile("" : : : "memory")
+#endif /* UNITY_BENCHMARK */
+
 //CppUTest Compatibility Macros
 #if defined(UNITY_CPP_UNIT_COMPAT)
 #define UT_PTR_SET(ptr, newPointerValue)               UnityPointer_Set((void**)&ptr, (void*)newPointerValue, unity_p)
+/* DX_PATCH: the new value is copied through a temporary of the target's type, so it can be a
+   literal or an expression of a narrower type. Without __typeof__ it has to be a variable of
+   the target's type. */
+#if defined(__GNUC__)
+#define UT_VALUE_SET(target, newValue)                 UnityValue_Set(&(target), &(__typeof__(target)){ (newValue) }, sizeof(target), unity_p)
+#else
+#define UT_VALUE_SET(target, newValue)                 UnityValue_Set(&(target), &(newValue), sizeof(target), unity_p)
+#endif
 #define TEST_ASSERT_POINTERS_EQUAL(expected, actual)   TEST_ASSERT_EQUAL_PTR(expected, actual)
 #define TEST_ASSERT_BYTES_EQUAL(expected, actual)      TEST_ASSERT_EQUAL_HEX8(0xff & (expected), 0xff & (actual))
 #define FAIL(message)                                  TEST_FAIL((message))
@@ -111,12 +215,27 @@ int UnityMain(int argc, char* argv[], void (*runAllTests)(struct _Unity * const
 
 #if defined(UNITY_DYNAMIC_MEM_DEBUG)
 void UnityMalloc_MakeMallocFailAfterCount(int count);
+void UnityMalloc_MakeMallocFailAtSite(const char * file, int line);
+void UnityMalloc_MakeMallocFailWithProbability(double probability, unsigned int seed);
+
+/* DX_PATCH: allocation budgets, checked against what the test allocated up to the assert */
+#define TEST_ASSERT_MAX_ALLOCATIONS(count) \
+    if (UnityMalloc_AssertMaxAllocations((unsigned long)(count), NULL, (UNITY_LINE_TYPE)__LINE__, __FILE__, unity_p) != 0) return;
+#define TEST_ASSERT_MAX_ALLOCATIONS_MESSAGE(count, message) \
+    if (UnityMalloc_AssertMaxAllocations((unsigned long)(count), (message), (UNITY_LINE_TYPE)__LINE__, __FILE__, unity_p) != 0) return;
+#define TEST_ASSERT_PEAK_BYTES(bytes) \
+    if (UnityMalloc_AssertPeakBytes((unsigned long)(bytes), NULL, (UNITY_LINE_TYPE)__LINE__, __FILE__, unity_p) != 0) return;
+#define TEST_ASSERT_PEAK_BYTES_MESSAGE(bytes, message) \
+    if (UnityMalloc_AssertPeakBytes((unsigned long)(bytes), (message), (UNITY_LINE_TYPE)__LINE__, __FILE__, unity_p) != 0) return;
 
 /* DX_PATCH: Pre-declarations required to avoid warnings */
 void * unity_malloc(size_t size);
 void unity_free(void * mem);
 void* unity_calloc(size_t num, size_t size);
 void* unity_realloc(void * oldMem, size_t size);
+void * unity_malloc_at(size_t size, const char * file, int line);
+void* unity_calloc_at(size_t num, size_t size, const char * file, int line);
+void* unity_realloc_at(void * oldMem, size_t size, const char * file, int line);
 
 #endif // UNITY_DYNAMIC_MEM_DEBUG
 
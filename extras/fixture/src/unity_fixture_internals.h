@@ -20,13 +20,153 @@ void UnityTestRunner(unityfunction * setup,
         const char * file, int line, struct _Unity * const unity_p);
 
 void UnityIgnoreTest(const char * printableName, struct _Unity * const unity_p);
-void UnityMalloc_StartTest(void);
+void UnityMalloc_StartTest(struct _Unity * const unity_p);
 void UnityMalloc_EndTest(struct _Unity * const unity_p);
+
+#if defined(UNITY_DYNAMIC_MEM_DEBUG)
+const UnityAllocationStats * UnityMalloc_Stats(const struct _Unity * const unity_p);
+void UnityMalloc_RestoreStats(const UnityAllocationStats * stats, struct _Unity * const unity_p);
+int UnityMalloc_LiveBlocks(const struct _Unity * const unity_p);
+void UnityMalloc_FailAllocation(long index, struct _Unity * const unity_p);
+void UnityMalloc_PrintStats(struct _Unity * const unity_p);
+bool UnityMalloc_AssertMaxAllocations(unsigned long limit, const char * msg,
+                                      const UNITY_LINE_TYPE line, const char * file, struct _Unity * const unity_p);
+bool UnityMalloc_AssertPeakBytes(unsigned long limit, const char * msg,
+                                 const UNITY_LINE_TYPE line, const char * file, struct _Unity * const unity_p);
+#endif
 int UnityFailureCount(struct _Unity * const unity_p);
 int UnityGetCommandLineOptions(int argc, char* argv[], struct _Unity * const unity_p);
 void UnityConcludeFixtureTest(struct _Unity * const unity_p);
 
+#if defined(UNITY_PARALLEL)
+void UnityParallel_Begin(struct _Unity * const unity_p);
+void UnityParallel_Run(struct _Unity * const unity_p);
+void UnityParallel_End(struct _Unity * const unity_p);
+void UnityParallel_Progress(const struct _Unity * const unity_p,
+        UNITY_COUNTER_TYPE * tests, UNITY_COUNTER_TYPE * failures, UNITY_COUNTER_TYPE * ignores);
+#endif
+
+#if defined(UNITY_PERF_COUNTERS)
+int UnityPerf_Select(const char * list, struct _Unity * const unity_p);
+void UnityPerf_Start(struct _UnityPerfCounters * perf);
+void UnityPerf_Stop(struct _UnityPerfCounters * perf);
+unsigned long long UnityPerf_Scale(unsigned long long value, unsigned long long enabled, unsigned long long running);
+void UnityPerf_Print(struct _Unity * const unity_p);
+#endif
+
+#if defined(UNITY_BENCHMARK)
+// What a benchmark does to the caches before every iteration, see UNITY_BENCH_SET_CACHE
+typedef enum
+{
+    UNITY_BENCH_HOT = 0,            // nothing, the input stays cached from the iteration before
+    UNITY_BENCH_COLD,               // sweeps a buffer larger than the caches, which also empties the TLB
+    UNITY_BENCH_FLUSH,              // flushes the lines of the input from every cache level
+    UNITY_BENCH_ROTATE              // moves the input to the next of a number of copies
+} UNITY_BENCH_CACHE_MODE_T;
+
+typedef struct _UnityBenchPoint
+{
+    unsigned long N;                // argument of a TEST_BENCHMARK_RANGE, 0 otherwise
+    unsigned long Iterations;       // of each sample
+    unsigned int SampleCount;
+    double RealNs[UNITY_BENCH_MAX_SAMPLES];     // nanoseconds per iteration of every sample
+    double CpuNs[UNITY_BENCH_MAX_SAMPLES];
+    double NsPerOp;                 // median of the samples
+    double MinNsPerOp;
+    double CpuNsPerOp;
+    double BytesPerOp;              // as set by UNITY_BENCH_SET_BYTES, 0 for none
+    double ItemsPerOp;
+    int CacheMode;
+    unsigned int Copies;            // the input was rotated through, for UNITY_BENCH_ROTATE
+    double Cv;                      // coefficient of variation of the samples
+    unsigned int Reruns;            // times the samples were taken again because Cv was too high
+    int Unreliable;                 // Cv stayed above --max-cv
+#if defined(UNITY_PERF_COUNTERS)
+    double CountersPerOp[UNITY_PERF_MAX_EVENTS];    // summed over the samples until the point is done
+    int CounterValid[UNITY_PERF_MAX_EVENTS];
+#endif
+} UnityBenchPoint;
+
+typedef struct _UnityBenchmark
+{
+    const char * Name;
+    struct _Unity * Unity;
+    unsigned long N;
+    unsigned long RangeEnd;         // TEST_BENCHMARK_RANGE runs N up to here, multiplied by RangeMultiplier
+    unsigned long RangeMultiplier;  // 0 for a single run
+    unsigned long Iterations;       // of each batch
+    int Calibrating;                // still growing Iterations
+    int Batches;                    // bodies that ran UNITY_BENCH_LOOP
+    unsigned long long StartTicks;
+    unsigned long long StartCpuNs;
+    double BatchNs;                 // the last batch, overhead not yet subtracted
+    double BatchCpuNs;
+    double BytesPerOp;
+    double ItemsPerOp;
+    int CacheMode;
+    unsigned int Copies;            // requested for UNITY_BENCH_ROTATE, 0 for UNITY_BENCH_REFERENCE_BYTES of them
+    void * InputPointer;            // the variable UNITY_BENCH_INPUT points at the input
+    const void * Input;
+    size_t InputBytes;
+    unsigned char * CopyBuffer;
+    unsigned int * CopyOrder;       // a shuffle of the copies, CopyIndex walks it
+    size_t CopyStride;
+    unsigned int CopyCount;
+    unsigned int CopyIndex;
+    unsigned long long PausedTicks; // spent preparing the caches inside the current batch
+    unsigned long Pauses;
+    double PreparedNs;
+    const char * Variants[2];       // implementations of a TEST_BENCHMARK_COMPARE, NULL otherwise
+    int Variant;                    // the one the current batch runs
+    int SecondOfPair;
+    double MinSpeedup;              // fraction of the time of A that B has to save, 0 for none
+    unsigned int Random;
+    double Ratio;                   // time of B over time of A, with its 95% confidence interval
+    double RatioLow;
+    double RatioHigh;
+    unsigned int RatioPairs;        // pairs that both had a measurable time
+#if defined(UNITY_PERF_COUNTERS)
+    struct _UnityPerfCounters Perf;
+#endif
+    unsigned int PointCount;
+    UnityBenchPoint Points[UNITY_BENCH_MAX_POINTS];     // the one after PointCount collects samples
+    int Complexity;                 // index of the best fitting class, O(1) up to O(n^2), -1 for none
+    double ComplexityCoefficient;   // nanoseconds per iteration are about this times the class of N
+    double ComplexityCpuCoefficient;
+    double ComplexityRms;           // error of that fit, relative to the mean time
+} UnityBenchmark;
+
+void UnityBench_Init(UnityBenchmark * bench, const char * name, struct _Unity * const unity_p);
+void UnityBench_SetRange(UnityBenchmark * bench, unsigned long first, unsigned long last, unsigned long multiplier);
+void UnityBench_SetCompare(UnityBenchmark * bench, const char * implA, const char * implB, double percent);
+void UnityBench_SetInput(UnityBenchmark * bench, void * pointer, size_t bytes);
+unsigned long UnityBench_Start(UnityBenchmark * bench);
+int UnityBench_Prepare(UnityBenchmark * bench);
+int UnityBench_Stop(UnityBenchmark * bench);
+int UnityBench_Next(UnityBenchmark * bench);
+void UnityBench_Report(UnityBenchmark * bench);
+void UnityBench_FitComplexity(UnityBenchmark * bench);
+unsigned long long UnityBench_Ticks(void);
+void UnityBench_Calibration(double * nsPerTick, double * batchNs, double * loopNs);
+void UnityBench_ReferenceBandwidths(double * memcpyGbps, double * memsetGbps);
+int UnityBench_SelectCacheMode(const char * mode, struct _Unity * const unity_p);
+int UnityBench_Begin(int argc, char* argv[], struct _Unity * const unity_p);
+void UnityBench_End(struct _Unity * const unity_p);
+#if defined(UNITY_PERF_COUNTERS)
+void UnityBench_WriteTestCounters(struct _Unity * const unity_p);
+#endif
+#endif
+
+#if defined(UNITY_GOLDEN_FILES)
+bool UnityAssertMatchesGoldenFile(const char * path,
+                                  const void * actual,
+                                  size_t length,
+                                  const char * msg,
+                                  const UNITY_LINE_TYPE line, const char * file, struct _Unity * const unity_p);
+#endif
+
 void UnityPointer_Set(void ** ptr, void * newValue, struct _Unity * const unity_p);
+void UnityValue_Set(void * target, const void * newValue, size_t size, struct _Unity * const unity_p);
 void UnityPointer_UndoAllSets(struct _Unity * const unity_p);
 void UnityPointer_Init(struct _Unity * const unity_p);
 
@@ -8,9 +8,10 @@
 #ifndef UNITY_FIXTURE_MALLOC_OVERRIDES_H_
 #define UNITY_FIXTURE_MALLOC_OVERRIDES_H_
 
-#define malloc  unity_malloc
-#define calloc  unity_calloc
-#define realloc unity_realloc
+/* DX_PATCH: the allocating functions pass their call site, for UnityMalloc_MakeMallocFailAtSite */
+#define malloc(size)        unity_malloc_at((size), __FILE__, __LINE__)
+#define calloc(num, size)   unity_calloc_at((num), (size), __FILE__, __LINE__)
+#define realloc(mem, size)  unity_realloc_at((mem), (size), __FILE__, __LINE__)
 #define free    unity_free
 
 #endif /* UNITY_FIXTURE_MALLOC_OVERRIDES_H_ */
@@ -5,17 +5,39 @@
     [Released under MIT License. Please refer to license.txt for details]
 ========================================== */
 
+#include <string.h>
 #include "unity_fixture.h"
 
-static void runAllTests()
+static void runAllTests(struct _Unity * const unity_p)
 {
     RUN_TEST_GROUP(UnityFixture);
     RUN_TEST_GROUP(UnityCommandOptions);
     RUN_TEST_GROUP(LeakDetection)
+    RUN_TEST_GROUP(AllocationStats);
+    RUN_TEST_GROUP(SizeClasses);
+    RUN_TEST_GROUP(FailureInjection);
+#if defined(UNITY_GOLDEN_FILES)
+    RUN_TEST_GROUP(GoldenFile);
+#endif
+#if defined(UNITY_PERF_COUNTERS)
+    RUN_TEST_GROUP(PerfCounters);
+#endif
+#if defined(UNITY_BENCHMARK)
+    RUN_TEST_GROUP(Benchmark);
+#endif
+    RUN_TEST_GROUP(UnityMismatchReport);
+    RUN_TEST_GROUP(UnityMemoryDiff);
+    RUN_TEST_GROUP(UnityStreamCompare);
+    RUN_TEST_GROUP(UnityUlps);
+    RUN_TEST_GROUP(UnityDigest);
+    RUN_TEST_GROUP(UnityMemoryCompare);
 }
 
 int main(int argc, char* argv[])
 {
-    return UnityMain(argc, argv, runAllTests);
+    struct _Unity unity;
+
+    memset(&unity, 0, sizeof(unity));
+    return UnityMain(argc, argv, runAllTests, &unity);
 }
 
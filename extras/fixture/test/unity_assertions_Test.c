@@ -0,0 +1,611 @@
+/* ==========================================
+    Unity Project - A Test Framework for C
+    Copyright (c) 2007 Mike Karlesky, Mark VanderVoord, Greg Williams
+    [Released under MIT License. Please refer to license.txt for details]
+========================================== */
+
+/* DX_PATCH: anonymous mappings for the large buffers, which -std=c99 hides */
+#define _DEFAULT_SOURCE
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include "unity_fixture.h"
+#include "unity_output_Spy.h"
+
+/* DX_PATCH: a failing assert returns from the function it is in, so the asserts expected to fail
+   are made in functions of their own. The spy collects what they print, and the failure is taken
+   back afterwards so that the test itself can go on. */
+static int failureTakenBack(struct _Unity * const unity_p)
+{
+    int failed = unity_p->CurrentTestFailed;
+
+    UnityOutputCharSpy_Enable(0);
+    unity_p->CurrentTestFailed = 0;
+    return failed;
+}
+
+static void assertIntArray(const int* expected, const int* actual, _UU32 num_elements,
+                           struct _Unity * const unity_p)
+{
+    TEST_ASSERT_EQUAL_INT_ARRAY(expected, actual, num_elements);
+}
+
+static void assertMemoryArray(const void* expected, const void* actual, _UU32 length, _UU32 num_elements,
+                              struct _Unity * const unity_p)
+{
+    TEST_ASSERT_EQUAL_MEMORY_ARRAY(expected, actual, length, num_elements);
+}
+
+static void assertString(const char* expected, const char* actual, struct _Unity * const unity_p)
+{
+    TEST_ASSERT_EQUAL_STRING(expected, actual);
+}
+
+static void assertHexWithMessage(_UU32 expected, _UU32 actual, struct _Unity * const unity_p)
+{
+    TEST_ASSERT_EQUAL_HEX16_MESSAGE(expected, actual, "register");
+}
+
+// Zero filled and only backed by memory where it is written to, so a buffer can be larger than RAM
+static unsigned char* mapZeroes(size_t length)
+{
+    int flags = MAP_PRIVATE | MAP_ANONYMOUS;
+    void* memory;
+
+#if defined(MAP_NORESERVE)
+    flags |= MAP_NORESERVE;
+#endif
+    memory = mmap(NULL, length, PROT_READ | PROT_WRITE, flags, -1, 0);
+    return (memory == MAP_FAILED) ? NULL : (unsigned char*)memory;
+}
+
+static void unmap(unsigned char* memory, size_t length)
+{
+    if (memory != NULL)
+        munmap(memory, length);
+}
+
+//------------------------------------------------------------
+
+TEST_GROUP(UnityMismatchReport);
+
+TEST_SETUP(UnityMismatchReport)
+{
+    UnityOutputCharSpy_Create(4096);
+}
+
+TEST_TEAR_DOWN(UnityMismatchReport)
+{
+    unity_p->ReportAllMismatches = 0;
+    UnityOutputCharSpy_Destroy();
+}
+
+static const int expectedInts[] = { 1, 2, 3, 4, 5, 6, 7 };
+static const int actualInts[]   = { 1, 9, 3, 4, 0, 0, 7 };
+
+TEST(UnityMismatchReport, FirstMismatchOfAnIntArray)
+{
+    UnityOutputCharSpy_Enable(1);
+    assertIntArray(expectedInts, actualInts, 7, unity_p);
+    CHECK(failureTakenBack(unity_p));
+    CHECK(strstr(UnityOutputCharSpy_Get(), " Element 1 Expected 2 Was 9"));
+    CHECK(strstr(UnityOutputCharSpy_Get(), "Mismatched") == NULL);
+}
+
+TEST(UnityMismatchReport, EqualArrayReportsNothing)
+{
+    UnityOutputCharSpy_Enable(1);
+    assertIntArray(expectedInts, expectedInts, 7, unity_p);
+    CHECK(failureTakenBack(unity_p) == 0);
+    STRCMP_EQUAL("", UnityOutputCharSpy_Get());
+}
+
+TEST(UnityMismatchReport, FirstMismatchOfAMemoryArray)
+{
+    const unsigned char expected[12] = { 0 };
+    const unsigned char actual[12] = { 0, 0, 0, 0, 0, 0, 0, 0, 0, 7, 0, 7 };
+
+    UnityOutputCharSpy_Enable(1);
+    assertMemoryArray(expected, actual, 4, 3, unity_p);
+    CHECK(failureTakenBack(unity_p));
+    CHECK(strstr(UnityOutputCharSpy_Get(), " Element 2 Byte 1 Expected 0x00 Was 0x07"));
+}
+
+TEST(UnityMismatchReport, StringMismatch)
+{
+    UnityOutputCharSpy_Enable(1);
+    assertString("bar", "baz", unity_p);
+    CHECK(failureTakenBack(unity_p));
+    CHECK(strstr(UnityOutputCharSpy_Get(), " Expected 'bar' Was 'baz'"));
+}
+
+TEST(UnityMismatchReport, NumberMismatchKeepsTheMessage)
+{
+    UnityOutputCharSpy_Enable(1);
+    assertHexWithMessage(0x12, 0x1234, unity_p);
+    CHECK(failureTakenBack(unity_p));
+    CHECK(strstr(UnityOutputCharSpy_Get(), " Expected 0x0012 Was 0x1234. register"));
+}
+
+TEST(UnityMismatchReport, AllMismatchesOfAnIntArray)
+{
+    unity_p->ReportAllMismatches = 1;
+    UnityOutputCharSpy_Enable(1);
+    assertIntArray(expectedInts, actualInts, 7, unity_p);
+    CHECK(failureTakenBack(unity_p));
+    CHECK(strstr(UnityOutputCharSpy_Get(), " Element 1 Expected 2 Was 9. 3 Mismatched Elements: 1, 4-5"));
+}
+
+TEST(UnityMismatchReport, AllMismatchesOfAMemoryArray)
+{
+    const unsigned char expected[12] = { 0 };
+    const unsigned char actual[12] = { 0, 0, 0, 7, 7, 0, 0, 0, 0, 0, 0, 7 };
+
+    unity_p->ReportAllMismatches = 1;
+    UnityOutputCharSpy_Enable(1);
+    assertMemoryArray(expected, actual, 4, 3, unity_p);
+    CHECK(failureTakenBack(unity_p));
+    CHECK(strstr(UnityOutputCharSpy_Get(), " Element 0 Byte 3 Expected 0x00 Was 0x07. 3 Mismatched Bytes: 3-4, 11"));
+}
+
+// Every other element differs, which gives more ranges than are listed
+TEST(UnityMismatchReport, RangesAreCappedAtTheReportLimit)
+{
+    int expected[2 * UNITY_MISMATCH_REPORT_LIMIT + 2] = { 0 };
+    int actual[2 * UNITY_MISMATCH_REPORT_LIMIT + 2] = { 0 };
+    char text[32];
+    int i;
+
+    for (i = 0; i < 2 * UNITY_MISMATCH_REPORT_LIMIT + 2; i += 2)
+        actual[i] = 1;
+    unity_p->ReportAllMismatches = 1;
+    UnityOutputCharSpy_Enable(1);
+    assertIntArray(expected, actual, 2 * UNITY_MISMATCH_REPORT_LIMIT + 2, unity_p);
+    CHECK(failureTakenBack(unity_p));
+    snprintf(text, sizeof(text), ". %d Mismatched Elements: 0, 2,", UNITY_MISMATCH_REPORT_LIMIT + 1);
+    CHECK(strstr(UnityOutputCharSpy_Get(), text));
+    snprintf(text, sizeof(text), ", %d, ...", 2 * (UNITY_MISMATCH_REPORT_LIMIT - 1));
+    CHECK(strstr(UnityOutputCharSpy_Get(), text));
+}
+
+//------------------------------------------------------------
+
+/* DX_PATCH: the rows below are written for the default geometry of the dump */
+#if (UNITY_MEMORY_DIFF_CONTEXT == 16) && (UNITY_MEMORY_DIFF_WIDTH == 16)
+#define HEX_ZEROES_8 " 00 00 00 00 00 00 00 00"
+#endif
+
+TEST_GROUP(UnityMemoryDiff);
+
+TEST_SETUP(UnityMemoryDiff)
+{
+    UnityOutputCharSpy_Create(4096);
+}
+
+TEST_TEAR_DOWN(UnityMemoryDiff)
+{
+    UnityOutputCharSpy_Destroy();
+}
+
+// The rows from 16 bytes before to 16 bytes after the mismatch, whole rows only
+TEST(UnityMemoryDiff, RowsAroundTheMismatch)
+{
+#if defined(HEX_ZEROES_8)
+    unsigned char expected[64] = { 0 };
+    unsigned char actual[64] = { 0 };
+    const char* output;
+
+    actual[40] = 0xAB;
+    UnityOutputCharSpy_Enable(1);
+    assertMemoryArray(expected, actual, 64, 1, unity_p);
+    CHECK(failureTakenBack(unity_p));
+    output = UnityOutputCharSpy_Get();
+    CHECK(strstr(output, "\n  00000000 ") == NULL);
+    CHECK(strstr(output, "\n  00000010 " HEX_ZEROES_8 HEX_ZEROES_8 " |" HEX_ZEROES_8 HEX_ZEROES_8));
+    CHECK(strstr(output, "\n  00000020 " HEX_ZEROES_8 ">00 00 00 00 00 00 00 00 |" HEX_ZEROES_8 ">AB 00 00 00 00 00 00 00"));
+    CHECK(strstr(output, "\n  00000030 " HEX_ZEROES_8 HEX_ZEROES_8 " |" HEX_ZEROES_8 HEX_ZEROES_8));
+#else
+    TEST_IGNORE_MESSAGE("Written for a 16 byte context and row");
+#endif
+}
+
+// The last row of the buffer is short; the expected side is padded so the actual side stays aligned
+TEST(UnityMemoryDiff, ShortLastRow)
+{
+#if defined(HEX_ZEROES_8)
+    unsigned char expected[20] = { 0 };
+    unsigned char actual[20] = { 0 };
+
+    actual[18] = 0x11;
+    actual[19] = 0x22;
+    UnityOutputCharSpy_Enable(1);
+    assertMemoryArray(expected, actual, 20, 1, unity_p);
+    CHECK(failureTakenBack(unity_p));
+    CHECK(strstr(UnityOutputCharSpy_Get(), "\n  00000000 " HEX_ZEROES_8 HEX_ZEROES_8 " |" HEX_ZEROES_8 HEX_ZEROES_8));
+    CHECK(strstr(UnityOutputCharSpy_Get(), "\n  00000010  00 00>00>00                                     | 00 00>11>22"));
+#else
+    TEST_IGNORE_MESSAGE("Written for a 16 byte context and row");
+#endif
+}
+
+// The dump follows the failure message
+TEST(UnityMemoryDiff, DumpFollowsTheMessage)
+{
+    unsigned char expected[4] = { 1, 2, 3, 4 };
+    unsigned char actual[4] = { 1, 2, 3, 5 };
+    const char* output;
+
+    UnityOutputCharSpy_Enable(1);
+    assertMemoryArray(expected, actual, 4, 1, unity_p);
+    CHECK(failureTakenBack(unity_p));
+    output = UnityOutputCharSpy_Get();
+    CHECK(strstr(output, " Byte 3 Expected 0x04 Was 0x05\n  00000000 "));
+}
+
+//------------------------------------------------------------
+
+TEST_GROUP(UnityStreamCompare);
+
+TEST_SETUP(UnityStreamCompare)
+{
+    UnityOutputCharSpy_Create(1000);
+}
+
+TEST_TEAR_DOWN(UnityStreamCompare)
+{
+    UnityOutputCharSpy_Destroy();
+}
+
+// Feeds both buffers in chunks of their own size, refilling whichever side ran dry
+static void compareStreams(const unsigned char* expected, _UU32 expectedTotal, _UU32 expectedChunk,
+                           const unsigned char* actual, _UU32 actualTotal, _UU32 actualChunk,
+                           struct _Unity * const unity_p)
+{
+    UnityStreamCompare stream;
+    _UU32 expectedLen = 0;
+    _UU32 actualLen = 0;
+
+    UnityStreamCompareBegin(&stream);
+    for (;;)
+    {
+        if ((expectedLen == 0) && (expectedTotal > 0))
+        {
+            expectedLen = (expectedChunk < expectedTotal) ? expectedChunk : expectedTotal;
+            expectedTotal -= expectedLen;
+        }
+        if ((actualLen == 0) && (actualTotal > 0))
+        {
+            actualLen = (actualChunk < actualTotal) ? actualChunk : actualTotal;
+            actualTotal -= actualLen;
+        }
+        if ((expectedLen == 0) || (actualLen == 0))
+            break;
+        TEST_ASSERT_STREAM_FEED(&stream, expected, expectedLen, actual, actualLen);
+    }
+    TEST_ASSERT_STREAM_END(&stream, expectedLen + expectedTotal, actualLen + actualTotal);
+}
+
+static const unsigned char streamData[] = "abcdefghijklmnopqrstuvwxyz";
+
+TEST(UnityStreamCompare, ChunksOfDifferentSizesMatch)
+{
+    unsigned char copy[sizeof(streamData)];
+
+    memcpy(copy, streamData, sizeof(copy));
+    compareStreams(streamData, 26, 3, copy, 26, 7, unity_p);
+    CHECK(!unity_p->CurrentTestFailed);
+}
+
+TEST(UnityStreamCompare, MismatchReportsTheStreamOffset)
+{
+    unsigned char copy[sizeof(streamData)];
+
+    memcpy(copy, streamData, sizeof(copy));
+    copy[17] = 'R';
+    UnityOutputCharSpy_Enable(1);
+    compareStreams(streamData, 26, 3, copy, 26, 7, unity_p);
+    CHECK(failureTakenBack(unity_p));
+    CHECK(strstr(UnityOutputCharSpy_Get(), " Stream Mismatch. Byte 17 Expected 0x72 Was 0x52"));
+}
+
+TEST(UnityStreamCompare, ShorterStreamFailsAtTheEnd)
+{
+    UnityOutputCharSpy_Enable(1);
+    compareStreams(streamData, 26, 3, streamData, 20, 7, unity_p);
+    CHECK(failureTakenBack(unity_p));
+    CHECK(strstr(UnityOutputCharSpy_Get(), " Stream Length Mismatch. Expected 26 Was 20"));
+}
+
+//------------------------------------------------------------
+
+TEST_GROUP(UnityUlps);
+
+TEST_SETUP(UnityUlps)
+{
+    UnityOutputCharSpy_Create(1000);
+}
+
+TEST_TEAR_DOWN(UnityUlps)
+{
+    UnityOutputCharSpy_Destroy();
+}
+
+#ifndef UNITY_EXCLUDE_FLOAT
+static _UF floatFromBits(_UU32 bits)
+{
+    _UF value;
+    memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+static void assertFloatUlps(_UU32 ulps, _UF expected, _UF actual, struct _Unity * const unity_p)
+{
+    TEST_ASSERT_FLOAT_ULPS(ulps, expected, actual);
+}
+
+static void assertFloatArrayUlps(_UU32 ulps, const _UF* expected, const _UF* actual, _UU32 num_elements,
+                                 struct _Unity * const unity_p)
+{
+    TEST_ASSERT_FLOAT_ARRAY_ULPS(ulps, expected, actual, num_elements);
+}
+#endif
+
+#ifndef UNITY_EXCLUDE_DOUBLE
+static _UD doubleFromBits(_UU64 bits)
+{
+    _UD value;
+    memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+static void assertDoubleUlps(_UU64 ulps, _UD expected, _UD actual, struct _Unity * const unity_p)
+{
+    TEST_ASSERT_DOUBLE_ULPS(ulps, expected, actual);
+}
+#endif
+
+TEST(UnityUlps, NeighbouringFloatsAreOneUlpApart)
+{
+#ifndef UNITY_EXCLUDE_FLOAT
+    TEST_ASSERT_FLOAT_ULPS(1, 1.0f, floatFromBits(0x3F800001u));
+    UnityOutputCharSpy_Enable(1);
+    assertFloatUlps(0, 1.0f, floatFromBits(0x3F800001u), unity_p);
+    CHECK(failureTakenBack(unity_p));
+    CHECK(strstr(UnityOutputCharSpy_Get(), " Values 1 ULPs Apart, Allowed 0. Expected 0x3F800000 Was 0x3F800001"));
+#else
+    TEST_IGNORE_MESSAGE("Float excluded");
+#endif
+}
+
+// -0 and +0 share a key, and the keys of the smallest subnormals of either sign are two apart
+TEST(UnityUlps, FloatKeysAreContinuousAcrossZero)
+{
+#ifndef UNITY_EXCLUDE_FLOAT
+    TEST_ASSERT_FLOAT_ULPS(0, floatFromBits(0x80000000u), 0.0f);
+    TEST_ASSERT_FLOAT_ULPS(2, floatFromBits(0x80000001u), floatFromBits(0x00000001u));
+    UnityOutputCharSpy_Enable(1);
+    assertFloatUlps(1, floatFromBits(0x80000001u), floatFromBits(0x00000001u), unity_p);
+    CHECK(failureTakenBack(unity_p));
+    CHECK(strstr(UnityOutputCharSpy_Get(), " Values 2 ULPs Apart, Allowed 1."));
+#else
+    TEST_IGNORE_MESSAGE("Float excluded");
+#endif
+}
+
+TEST(UnityUlps, FloatNaNNeverMatches)
+{
+#ifndef UNITY_EXCLUDE_FLOAT
+    const _UF nan = floatFromBits(0x7FC00000u);
+
+    UnityOutputCharSpy_Enable(1);
+    assertFloatUlps(0xFFFFFFFFu, nan, nan, unity_p);
+    CHECK(failureTakenBack(unity_p));
+    CHECK(strstr(UnityOutputCharSpy_Get(), " Values Not Comparable (NaN) Expected 0x7FC00000 Was 0x7FC00000"));
+#else
+    TEST_IGNORE_MESSAGE("Float excluded");
+#endif
+}
+
+// The failing element lies past the first block of the vectorized check
+TEST(UnityUlps, FloatArrayReportsTheFailingElement)
+{
+#ifndef UNITY_EXCLUDE_FLOAT
+    _UF expected[100];
+    _UF actual[100];
+    int i;
+
+    for (i = 0; i < 100; i++)
+        expected[i] = actual[i] = (_UF)i;
+    actual[70] = floatFromBits(0x428C0003u);    // 70.0f is 0x428C0000
+    TEST_ASSERT_FLOAT_ARRAY_ULPS(3, expected, actual, 100);
+    UnityOutputCharSpy_Enable(1);
+    assertFloatArrayUlps(2, expected, actual, 100, unity_p);
+    CHECK(failureTakenBack(unity_p));
+    CHECK(strstr(UnityOutputCharSpy_Get(), " Element 70 Values 3 ULPs Apart, Allowed 2."));
+#else
+    TEST_IGNORE_MESSAGE("Float excluded");
+#endif
+}
+
+TEST(UnityUlps, DoubleKeysAreContinuousAcrossZero)
+{
+#ifndef UNITY_EXCLUDE_DOUBLE
+    TEST_ASSERT_DOUBLE_ULPS(1, 1.0, doubleFromBits(0x3FF0000000000001ull));
+    TEST_ASSERT_DOUBLE_ULPS(0, doubleFromBits(0x8000000000000000ull), 0.0);
+    TEST_ASSERT_DOUBLE_ULPS(2, doubleFromBits(0x8000000000000001ull), doubleFromBits(0x0000000000000001ull));
+    UnityOutputCharSpy_Enable(1);
+    assertDoubleUlps(0, 1.0, doubleFromBits(0x3FF0000000000001ull), unity_p);
+    CHECK(failureTakenBack(unity_p));
+    CHECK(strstr(UnityOutputCharSpy_Get(), " Values 1 ULPs Apart, Allowed 0. Expected 0x3FF0000000000000 Was 0x3FF0000000000001"));
+#else
+    TEST_IGNORE_MESSAGE("Double excluded");
+#endif
+}
+
+//------------------------------------------------------------
+
+TEST_GROUP(UnityDigest);
+
+TEST_SETUP(UnityDigest)
+{
+    UnityOutputCharSpy_Create(1000);
+}
+
+TEST_TEAR_DOWN(UnityDigest)
+{
+    unity_p->RecordDigests = 0;
+    UnityOutputCharSpy_Destroy();
+}
+
+#ifdef UNITY_SUPPORT_64
+static void assertDigest(_UU64 expected, const void* actual, _UU32 length, struct _Unity * const unity_p)
+{
+    TEST_ASSERT_DIGEST_EQUAL(expected, actual, length);
+}
+#endif
+
+// Reference values of XXH64 with seed 0
+TEST(UnityDigest, KnownDigests)
+{
+#ifdef UNITY_SUPPORT_64
+    TEST_ASSERT_DIGEST_EQUAL(0xEF46DB3751D8E999ull, "", 0);
+    TEST_ASSERT_DIGEST_EQUAL(0xD24EC4F1A98C6E5Bull, "a", 1);
+    TEST_ASSERT_DIGEST_EQUAL(0x44BC2CF5AD770999ull, "abc", 3);
+    TEST_ASSERT_DIGEST_EQUAL(0x0B242D361FDA71BCull, "The quick brown fox jumps over the lazy dog", 43);
+#else
+    TEST_IGNORE_MESSAGE("Needs UNITY_SUPPORT_64");
+#endif
+}
+
+// Several 32 byte stripes and every kind of tail, at an address that is not 8 byte aligned
+TEST(UnityDigest, LongUnalignedInput)
+{
+#ifdef UNITY_SUPPORT_64
+    unsigned char buffer[1 + 1027];
+    int i;
+
+    for (i = 0; i < 1024; i++)
+        buffer[1 + i] = (unsigned char)i;
+    memcpy(&buffer[1 + 1024], "xyz", 3);
+    TEST_ASSERT_DIGEST_EQUAL(0xE146CB31B65BC21Aull, &buffer[1], 1027);
+#else
+    TEST_IGNORE_MESSAGE("Needs UNITY_SUPPORT_64");
+#endif
+}
+
+TEST(UnityDigest, MismatchShowsBothDigests)
+{
+#ifdef UNITY_SUPPORT_64
+    UnityOutputCharSpy_Enable(1);
+    assertDigest(0x0123456789ABCDEFull, "abc", 3, unity_p);
+    CHECK(failureTakenBack(unity_p));
+    CHECK(strstr(UnityOutputCharSpy_Get(), " Digest Mismatch. Expected 0x0123456789ABCDEF Was 0x44BC2CF5AD770999"));
+#else
+    TEST_IGNORE_MESSAGE("Needs UNITY_SUPPORT_64");
+#endif
+}
+
+TEST(UnityDigest, RecordModePrintsTheDigestAndPasses)
+{
+#ifdef UNITY_SUPPORT_64
+    unity_p->RecordDigests = 1;
+    UnityOutputCharSpy_Enable(1);
+    assertDigest(0, "abc", 3, unity_p);
+    CHECK(!failureTakenBack(unity_p));
+    CHECK(strstr(UnityOutputCharSpy_Get(), ":DIGEST: 0x44BC2CF5AD770999\n"));
+#else
+    TEST_IGNORE_MESSAGE("Needs UNITY_SUPPORT_64");
+#endif
+}
+
+//------------------------------------------------------------
+
+TEST_GROUP(UnityMemoryCompare);
+
+static unsigned char* expectedBuffer;
+static unsigned char* actualBuffer;
+static size_t bufferLength;
+
+TEST_SETUP(UnityMemoryCompare)
+{
+    expectedBuffer = NULL;
+    actualBuffer = NULL;
+    bufferLength = 0;
+    UnityOutputCharSpy_Create(4096);
+}
+
+TEST_TEAR_DOWN(UnityMemoryCompare)
+{
+    unmap(expectedBuffer, bufferLength);
+    unmap(actualBuffer, bufferLength);
+    UnityOutputCharSpy_Destroy();
+}
+
+static int mapBuffers(size_t length)
+{
+    bufferLength = length;
+    expectedBuffer = mapZeroes(length);
+    actualBuffer = mapZeroes(length);
+    return (expectedBuffer != NULL) && (actualBuffer != NULL);
+}
+
+TEST(UnityMemoryCompare, SmallMismatchIsFound)
+{
+    unsigned char expected[40] = { 0 };
+    unsigned char actual[40] = { 0 };
+
+    actual[21] = 0x5A;
+    UnityOutputCharSpy_Enable(1);
+    assertMemoryArray(expected, actual, 8, 5, unity_p);
+    CHECK(failureTakenBack(unity_p));
+    CHECK(strstr(UnityOutputCharSpy_Get(), " Memory Mismatch. Element 2 Byte 5 Expected 0x00 Was 0x5A"));
+}
+
+// The threshold is the smallest compare that is split across threads
+TEST(UnityMemoryCompare, ParallelCompareOfEqualBuffersPasses)
+{
+    if (!mapBuffers(UNITY_PARALLEL_COMPARE_THRESHOLD))
+        TEST_IGNORE_MESSAGE("Cannot map the buffers");
+    assertMemoryArray(expectedBuffer, actualBuffer, UNITY_PARALLEL_COMPARE_THRESHOLD, 1, unity_p);
+    CHECK(!unity_p->CurrentTestFailed);
+}
+
+// Mismatches in the second and the last chunk, only the earlier one is reported
+TEST(UnityMemoryCompare, ParallelCompareReportsTheFirstMismatch)
+{
+    const size_t chunk = UNITY_PARALLEL_COMPARE_THRESHOLD / 4;
+    char text[96];
+
+    if (!mapBuffers(UNITY_PARALLEL_COMPARE_THRESHOLD))
+        TEST_IGNORE_MESSAGE("Cannot map the buffers");
+    actualBuffer[3 * chunk + 5] = 0x01;
+    actualBuffer[chunk + 7] = 0x02;
+    UnityOutputCharSpy_Enable(1);
+    assertMemoryArray(expectedBuffer, actualBuffer, UNITY_PARALLEL_COMPARE_THRESHOLD, 1, unity_p);
+    CHECK(failureTakenBack(unity_p));
+    snprintf(text, sizeof(text), " Memory Mismatch. Byte %lu Expected 0x00 Was 0x02", (unsigned long)(chunk + 7));
+    CHECK(strstr(UnityOutputCharSpy_Get(), text));
+}
+
+// The elements of an array assert add up to more than 4 GiB, which a 32 bit offset cannot reach
+TEST(UnityMemoryCompare, MismatchPast4GiBIsFound)
+{
+#if defined(UINTPTR_MAX) && (UINTPTR_MAX > 0xFFFFFFFFu)
+    const _UU32 length = 1024u * 1024u;
+    const _UU32 elements = 4097u;
+
+    if (!mapBuffers((size_t)length * elements))
+        TEST_IGNORE_MESSAGE("Cannot map 4 GiB");
+    actualBuffer[((size_t)4096u << 20) + 100] = 0x01;
+    UnityOutputCharSpy_Enable(1);
+    assertMemoryArray(expectedBuffer, actualBuffer, length, elements, unity_p);
+    CHECK(failureTakenBack(unity_p));
+    CHECK(strstr(UnityOutputCharSpy_Get(), " Memory Mismatch. Element 4096 Byte 100 Expected 0x00 Was 0x01"));
+    // the hex dump widens its address column to the 9 digits of the offset
+    CHECK(strstr(UnityOutputCharSpy_Get(), "  100000060 "));
+#else
+    TEST_IGNORE_MESSAGE("Needs a 64 bit address space");
+#endif
+}
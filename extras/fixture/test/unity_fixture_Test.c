@@ -5,12 +5,23 @@
     [Released under MIT License. Please refer to license.txt for details]
 ========================================== */
 
-#include "unity_fixture.h"
-#include "unity_output_Spy.h"
+/* DX_PATCH: clock_gettime, to check the benchmark timer against */
+#if defined(UNITY_BENCHMARK) && !defined(_POSIX_C_SOURCE)
+#define _POSIX_C_SOURCE 200809L
+#endif
+
+/* DX_PATCH: the system headers go first, the malloc overrides cannot follow them */
+#include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
-
-extern UNITY_FIXTURE_T UnityFixture;
+#if defined(UNITY_BENCHMARK)
+#include <time.h>
+#endif
+#include "unity_fixture.h"
+#include "unity_output_Spy.h"
+#if defined(UNITY_PARALLEL)
+#include <pthread.h>
+#endif
 
 TEST_GROUP(UnityFixture);
 
@@ -41,7 +52,7 @@ TEST(UnityFixture, PointerSetting)
     TEST_ASSERT_POINTERS_EQUAL(pointer2, &int2);
     TEST_ASSERT_POINTERS_EQUAL(pointer3, &int3);
     UT_PTR_SET(pointer1, &int4);
-    UnityPointer_UndoAllSets();
+    UnityPointer_UndoAllSets(unity_p);
     TEST_ASSERT_POINTERS_EQUAL(pointer1, 0);
     TEST_ASSERT_POINTERS_EQUAL(pointer2, (int*)2);
     TEST_ASSERT_POINTERS_EQUAL(pointer3, (int*)3);
@@ -80,7 +91,8 @@ TEST(UnityFixture, ReallocLargerNeeded)
     void* m1 = malloc(10);
     void* m2;
     strcpy((char*)m1, "123456789");
-    m2 = realloc(m1, 15);
+    // past the size class of the block, which would otherwise grow in place
+    m2 = realloc(m1, 100);
     CHECK(m1 != m2);
     STRCMP_EQUAL("123456789", m2);
     free(m2);
@@ -122,39 +134,67 @@ TEST(UnityFixture, PointerSet)
     p1 = &c1;
     p2 = &c2;
 
-    UnityPointer_Init(10);
+    UnityPointer_Init(unity_p);
     UT_PTR_SET(p1, &newC1);
     UT_PTR_SET(p2, &newC2);
     TEST_ASSERT_POINTERS_EQUAL(&newC1, p1);
     TEST_ASSERT_POINTERS_EQUAL(&newC2, p2);
-    UnityPointer_UndoAllSets();
+    UnityPointer_UndoAllSets(unity_p);
     TEST_ASSERT_POINTERS_EQUAL(&c1, p1);
     TEST_ASSERT_POINTERS_EQUAL(&c2, p2);
 }
 
+static long long bigValue = 1;
+static struct { int a; char b[10]; } recordValue = { 7, "seven" };
+
+TEST(UnityFixture, ValueSetTakesALiteral)
+{
+    UnityPointer_Init(unity_p);
+    UT_VALUE_SET(bigValue, 5);
+    TEST_ASSERT_EQUAL_INT64(5, bigValue);
+    UnityPointer_UndoAllSets(unity_p);
+    TEST_ASSERT_EQUAL_INT64(1, bigValue);
+}
+
+// a char is widened to the target's type instead of being read past its end
+TEST(UnityFixture, ValueSetWidensANarrowerValue)
+{
+    char small = -3;
+
+    UnityPointer_Init(unity_p);
+    UT_VALUE_SET(bigValue, small);
+    TEST_ASSERT_EQUAL_INT64(-3, bigValue);
+    UnityPointer_UndoAllSets(unity_p);
+    TEST_ASSERT_EQUAL_INT64(1, bigValue);
+}
+
+TEST(UnityFixture, ValueSetRestoresInReverseOrder)
+{
+    UnityPointer_Init(unity_p);
+    UT_VALUE_SET(recordValue.a, 8);
+    UT_VALUE_SET(recordValue.a, 9);
+    UT_VALUE_SET(recordValue.b[0], 'S');
+    TEST_ASSERT_EQUAL(9, recordValue.a);
+    TEST_ASSERT_EQUAL_STRING("Seven", recordValue.b);
+    UnityPointer_UndoAllSets(unity_p);
+    TEST_ASSERT_EQUAL(7, recordValue.a);
+    TEST_ASSERT_EQUAL_STRING("seven", recordValue.b);
+}
+
 //------------------------------------------------------------
 
 TEST_GROUP(UnityCommandOptions);
 
-int savedVerbose;
-int savedRepeat;
-const char* savedName;
-const char* savedGroup;
+/* DX_PATCH: the options are parsed into a context of their own, the running test keeps its own */
+static struct _Unity options;
 
 TEST_SETUP(UnityCommandOptions)
 {
-    savedVerbose = UnityFixture.Verbose;
-    savedRepeat = UnityFixture.RepeatCount;
-    savedName = UnityFixture.NameFilter;
-    savedGroup = UnityFixture.GroupFilter;
+    memset(&options, 0, sizeof(options));
 }
 
 TEST_TEAR_DOWN(UnityCommandOptions)
 {
-    UnityFixture.Verbose = savedVerbose;
-    UnityFixture.RepeatCount= savedRepeat;
-    UnityFixture.NameFilter = savedName;
-    UnityFixture.GroupFilter = savedGroup;
 }
 
 
@@ -164,11 +204,13 @@ static char* noOptions[] = {
 
 TEST(UnityCommandOptions, DefaultOptions)
 {
-    UnityGetCommandLineOptions(1, noOptions);
-    TEST_ASSERT_EQUAL(0, UnityFixture.Verbose);
-    TEST_ASSERT_POINTERS_EQUAL(0, UnityFixture.GroupFilter);
-    TEST_ASSERT_POINTERS_EQUAL(0, UnityFixture.NameFilter);
-    TEST_ASSERT_EQUAL(1, UnityFixture.RepeatCount);
+    UnityGetCommandLineOptions(1, noOptions, &options);
+    TEST_ASSERT_EQUAL(0, options.Verbose);
+    TEST_ASSERT_POINTERS_EQUAL(0, options.GroupFilter);
+    TEST_ASSERT_POINTERS_EQUAL(0, options.NameFilter);
+    TEST_ASSERT_EQUAL(1, options.RepeatCount);
+    TEST_ASSERT_EQUAL(0, options.RepeatTestCount);
+    TEST_ASSERT_EQUAL(0, options.UntilFail);
 }
 
 static char* verbose[] = {
@@ -178,8 +220,8 @@ static char* verbose[] = {
 
 TEST(UnityCommandOptions, OptionVerbose)
 {
-    TEST_ASSERT_EQUAL(0, UnityGetCommandLineOptions(2, verbose));
-    TEST_ASSERT_EQUAL(1, UnityFixture.Verbose);
+    TEST_ASSERT_EQUAL(0, UnityGetCommandLineOptions(2, verbose, &options));
+    TEST_ASSERT_EQUAL(1, options.Verbose);
 }
 
 static char* group[] = {
@@ -189,8 +231,8 @@ static char* group[] = {
 
 TEST(UnityCommandOptions, OptionSelectTestByGroup)
 {
-    TEST_ASSERT_EQUAL(0, UnityGetCommandLineOptions(3, group));
-    STRCMP_EQUAL("groupname", UnityFixture.GroupFilter);
+    TEST_ASSERT_EQUAL(0, UnityGetCommandLineOptions(3, group, &options));
+    STRCMP_EQUAL("groupname", options.GroupFilter);
 }
 
 static char* name[] = {
@@ -200,8 +242,8 @@ static char* name[] = {
 
 TEST(UnityCommandOptions, OptionSelectTestByName)
 {
-    TEST_ASSERT_EQUAL(0, UnityGetCommandLineOptions(3, name));
-    STRCMP_EQUAL("testname", UnityFixture.NameFilter);
+    TEST_ASSERT_EQUAL(0, UnityGetCommandLineOptions(3, name, &options));
+    STRCMP_EQUAL("testname", options.NameFilter);
 }
 
 static char* repeat[] = {
@@ -211,14 +253,14 @@ static char* repeat[] = {
 
 TEST(UnityCommandOptions, OptionSelectRepeatTestsDefaultCount)
 {
-    TEST_ASSERT_EQUAL(0, UnityGetCommandLineOptions(2, repeat));
-    TEST_ASSERT_EQUAL(2, UnityFixture.RepeatCount);
+    TEST_ASSERT_EQUAL(0, UnityGetCommandLineOptions(2, repeat, &options));
+    TEST_ASSERT_EQUAL(2, options.RepeatCount);
 }
 
 TEST(UnityCommandOptions, OptionSelectRepeatTestsSpecificCount)
 {
-    TEST_ASSERT_EQUAL(0, UnityGetCommandLineOptions(3, repeat));
-    TEST_ASSERT_EQUAL(99, UnityFixture.RepeatCount);
+    TEST_ASSERT_EQUAL(0, UnityGetCommandLineOptions(3, repeat, &options));
+    TEST_ASSERT_EQUAL(99, options.RepeatCount);
 }
 
 static char* multiple[] = {
@@ -231,11 +273,11 @@ static char* multiple[] = {
 
 TEST(UnityCommandOptions, MultipleOptions)
 {
-    TEST_ASSERT_EQUAL(0, UnityGetCommandLineOptions(8, multiple));
-    TEST_ASSERT_EQUAL(1, UnityFixture.Verbose);
-    STRCMP_EQUAL("groupname", UnityFixture.GroupFilter);
-    STRCMP_EQUAL("testname", UnityFixture.NameFilter);
-    TEST_ASSERT_EQUAL(98, UnityFixture.RepeatCount);
+    TEST_ASSERT_EQUAL(0, UnityGetCommandLineOptions(8, multiple, &options));
+    TEST_ASSERT_EQUAL(1, options.Verbose);
+    STRCMP_EQUAL("groupname", options.GroupFilter);
+    STRCMP_EQUAL("testname", options.NameFilter);
+    TEST_ASSERT_EQUAL(98, options.RepeatCount);
 }
 
 static char* dashRNotLast[] = {
@@ -248,11 +290,11 @@ static char* dashRNotLast[] = {
 
 TEST(UnityCommandOptions, MultipleOptionsDashRNotLastAndNoValueSpecified)
 {
-    TEST_ASSERT_EQUAL(0, UnityGetCommandLineOptions(7, dashRNotLast));
-    TEST_ASSERT_EQUAL(1, UnityFixture.Verbose);
-    STRCMP_EQUAL("gggg", UnityFixture.GroupFilter);
-    STRCMP_EQUAL("tttt", UnityFixture.NameFilter);
-    TEST_ASSERT_EQUAL(2, UnityFixture.RepeatCount);
+    TEST_ASSERT_EQUAL(0, UnityGetCommandLineOptions(7, dashRNotLast, &options));
+    TEST_ASSERT_EQUAL(1, options.Verbose);
+    STRCMP_EQUAL("gggg", options.GroupFilter);
+    STRCMP_EQUAL("tttt", options.NameFilter);
+    TEST_ASSERT_EQUAL(2, options.RepeatCount);
 }
 
 static char* unknownCommand[] = {
@@ -265,13 +307,249 @@ static char* unknownCommand[] = {
 };
 TEST(UnityCommandOptions, UnknownCommandIsIgnored)
 {
-    TEST_ASSERT_EQUAL(0, UnityGetCommandLineOptions(9, unknownCommand));
-    TEST_ASSERT_EQUAL(1, UnityFixture.Verbose);
-    STRCMP_EQUAL("groupname", UnityFixture.GroupFilter);
-    STRCMP_EQUAL("testname", UnityFixture.NameFilter);
-    TEST_ASSERT_EQUAL(98, UnityFixture.RepeatCount);
+    TEST_ASSERT_EQUAL(0, UnityGetCommandLineOptions(9, unknownCommand, &options));
+    TEST_ASSERT_EQUAL(1, options.Verbose);
+    STRCMP_EQUAL("groupname", options.GroupFilter);
+    STRCMP_EQUAL("testname", options.NameFilter);
+    TEST_ASSERT_EQUAL(98, options.RepeatCount);
+}
+
+static char* repeatTest[] = {
+        "testrunner.exe",
+        "--repeat-test", "500"
+};
+
+TEST(UnityCommandOptions, OptionRepeatTest)
+{
+    TEST_ASSERT_EQUAL(0, UnityGetCommandLineOptions(3, repeatTest, &options));
+    TEST_ASSERT_EQUAL(500, options.RepeatTestCount);
+    TEST_ASSERT_EQUAL(0, options.UntilFail);
+    TEST_ASSERT_EQUAL(1, options.RepeatCount);
+}
+
+TEST(UnityCommandOptions, OptionRepeatTestNeedsACount)
+{
+    TEST_ASSERT_EQUAL(1, UnityGetCommandLineOptions(2, repeatTest, &options));
+}
+
+static char* untilFail[] = {
+        "testrunner.exe",
+        "--until-fail",
+        "--repeat-test", "20"
+};
+
+TEST(UnityCommandOptions, OptionUntilFail)
+{
+    TEST_ASSERT_EQUAL(0, UnityGetCommandLineOptions(2, untilFail, &options));
+    TEST_ASSERT_EQUAL(1, options.UntilFail);
+    TEST_ASSERT_EQUAL(0, options.RepeatTestCount);
+}
+
+TEST(UnityCommandOptions, OptionUntilFailWithRepeatTestLimit)
+{
+    TEST_ASSERT_EQUAL(0, UnityGetCommandLineOptions(4, untilFail, &options));
+    TEST_ASSERT_EQUAL(1, options.UntilFail);
+    TEST_ASSERT_EQUAL(20, options.RepeatTestCount);
+}
+
+static char* jobs[] = {
+        "testrunner.exe",
+        "-j", "4"
+};
+
+TEST(UnityCommandOptions, OptionJobs)
+{
+    TEST_ASSERT_EQUAL(0, UnityGetCommandLineOptions(1, jobs, &options));
+    TEST_ASSERT_EQUAL(1, options.Jobs);
+    TEST_ASSERT_EQUAL(0, UnityGetCommandLineOptions(3, jobs, &options));
+    TEST_ASSERT_EQUAL(4, options.Jobs);
+}
+
+TEST(UnityCommandOptions, OptionJobsNeedsACount)
+{
+    TEST_ASSERT_EQUAL(1, UnityGetCommandLineOptions(2, jobs, &options));
+}
+
+static char* orderedOutput[] = {
+        "testrunner.exe",
+        "--ordered-output"
+};
+
+TEST(UnityCommandOptions, OptionOrderedOutput)
+{
+    TEST_ASSERT_EQUAL(0, UnityGetCommandLineOptions(1, orderedOutput, &options));
+    TEST_ASSERT_EQUAL(0, options.OrderedOutput);
+    TEST_ASSERT_EQUAL(0, UnityGetCommandLineOptions(2, orderedOutput, &options));
+    TEST_ASSERT_EQUAL(1, options.OrderedOutput);
+}
+
+static char* updateGolden[] = {
+        "testrunner.exe",
+        "--update-golden"
+};
+
+TEST(UnityCommandOptions, OptionUpdateGolden)
+{
+    TEST_ASSERT_EQUAL(0, UnityGetCommandLineOptions(1, updateGolden, &options));
+    TEST_ASSERT_EQUAL(0, options.UpdateGolden);
+    TEST_ASSERT_EQUAL(0, UnityGetCommandLineOptions(2, updateGolden, &options));
+    TEST_ASSERT_EQUAL(1, options.UpdateGolden);
+}
+
+static char* allocSweep[] = {
+        "testrunner.exe",
+        "--alloc-sweep"
+};
+
+TEST(UnityCommandOptions, OptionAllocSweep)
+{
+    TEST_ASSERT_EQUAL(0, UnityGetCommandLineOptions(1, allocSweep, &options));
+    TEST_ASSERT_EQUAL(0, options.AllocSweep);
+    TEST_ASSERT_EQUAL(0, UnityGetCommandLineOptions(2, allocSweep, &options));
+    TEST_ASSERT_EQUAL(1, options.AllocSweep);
+}
+
+static char* allMismatches[] = {
+        "testrunner.exe",
+        "--all-mismatches"
+};
+
+TEST(UnityCommandOptions, OptionAllMismatches)
+{
+    TEST_ASSERT_EQUAL(0, UnityGetCommandLineOptions(1, allMismatches, &options));
+    TEST_ASSERT_EQUAL(0, options.ReportAllMismatches);
+    TEST_ASSERT_EQUAL(0, UnityGetCommandLineOptions(2, allMismatches, &options));
+    TEST_ASSERT_EQUAL(1, options.ReportAllMismatches);
+}
+
+static char* recordDigests[] = {
+        "testrunner.exe",
+        "--record-digests"
+};
+
+TEST(UnityCommandOptions, OptionRecordDigests)
+{
+    TEST_ASSERT_EQUAL(0, UnityGetCommandLineOptions(1, recordDigests, &options));
+    TEST_ASSERT_EQUAL(0, options.RecordDigests);
+    TEST_ASSERT_EQUAL(0, UnityGetCommandLineOptions(2, recordDigests, &options));
+    TEST_ASSERT_EQUAL(1, options.RecordDigests);
+}
+
+#if defined(UNITY_BENCHMARK)
+static char* benchmarkOut[] = {
+        "testrunner.exe",
+        "--benchmark-out", "results.json"
+};
+
+TEST(UnityCommandOptions, OptionBenchmarkOut)
+{
+    TEST_ASSERT_EQUAL(0, UnityGetCommandLineOptions(1, benchmarkOut, &options));
+    TEST_ASSERT_POINTERS_EQUAL(0, options.BenchmarkOut);
+    TEST_ASSERT_EQUAL(0, UnityGetCommandLineOptions(3, benchmarkOut, &options));
+    TEST_ASSERT_EQUAL_STRING("results.json", options.BenchmarkOut);
+}
+
+TEST(UnityCommandOptions, OptionBenchmarkOutNeedsAFile)
+{
+    TEST_ASSERT_EQUAL(1, UnityGetCommandLineOptions(2, benchmarkOut, &options));
+}
+
+static char* pinCpu[] = {
+        "testrunner.exe",
+        "--pin-cpu", "3",
+        "-j", "2"
+};
+
+TEST(UnityCommandOptions, OptionPinCpu)
+{
+    TEST_ASSERT_EQUAL(0, UnityGetCommandLineOptions(1, pinCpu, &options));
+    TEST_ASSERT_EQUAL(-1, options.PinCpu);
+    TEST_ASSERT_EQUAL(0, UnityGetCommandLineOptions(3, pinCpu, &options));
+    TEST_ASSERT_EQUAL(3, options.PinCpu);
+}
+
+TEST(UnityCommandOptions, OptionPinCpuNeedsANumber)
+{
+    TEST_ASSERT_EQUAL(1, UnityGetCommandLineOptions(2, pinCpu, &options));
+}
+
+TEST(UnityCommandOptions, OptionPinCpuRejectsJobs)
+{
+    TEST_ASSERT_EQUAL(1, UnityGetCommandLineOptions(5, pinCpu, &options));
+}
+
+static char* maxCv[] = {
+        "testrunner.exe",
+        "--max-cv", "2.5"
+};
+
+TEST(UnityCommandOptions, OptionMaxCv)
+{
+    TEST_ASSERT_EQUAL(0, UnityGetCommandLineOptions(1, maxCv, &options));
+    TEST_ASSERT_FLOAT_WITHIN(0.0001f, UNITY_BENCH_MAX_CV, options.BenchMaxCv);
+    TEST_ASSERT_EQUAL(0, UnityGetCommandLineOptions(3, maxCv, &options));
+    TEST_ASSERT_FLOAT_WITHIN(0.0001f, 0.025f, options.BenchMaxCv);
+}
+
+TEST(UnityCommandOptions, OptionMaxCvNeedsAPercentage)
+{
+    TEST_ASSERT_EQUAL(1, UnityGetCommandLineOptions(2, maxCv, &options));
+}
+
+static char* cacheMode[] = {
+        "testrunner.exe",
+        "--cache-mode", "flush",
+        "--cache-mode", "rotate:16",
+        "--cache-mode", "lukewarm"
+};
+
+TEST(UnityCommandOptions, OptionCacheMode)
+{
+    TEST_ASSERT_EQUAL(0, UnityGetCommandLineOptions(1, cacheMode, &options));
+    TEST_ASSERT_EQUAL(UNITY_BENCH_HOT, options.BenchCacheMode);
+    TEST_ASSERT_EQUAL(0, UnityGetCommandLineOptions(3, cacheMode, &options));
+    TEST_ASSERT_EQUAL(UNITY_BENCH_FLUSH, options.BenchCacheMode);
+    TEST_ASSERT_EQUAL(0, UnityGetCommandLineOptions(5, cacheMode, &options));
+    TEST_ASSERT_EQUAL(UNITY_BENCH_ROTATE, options.BenchCacheMode);
+    TEST_ASSERT_EQUAL(16, options.BenchRotateCopies);
+}
+
+TEST(UnityCommandOptions, OptionCacheModeRejectsAnUnknownMode)
+{
+    TEST_ASSERT_EQUAL(1, UnityGetCommandLineOptions(2, cacheMode, &options));
+    TEST_ASSERT_EQUAL(1, UnityGetCommandLineOptions(7, cacheMode, &options));
+}
+#endif
+
+#if defined(UNITY_PERF_COUNTERS)
+static char* perfCounters[] = {
+        "testrunner.exe",
+        "--perf-counters", "cycles,instructions,page-faults"
+};
+
+TEST(UnityCommandOptions, OptionPerfCounters)
+{
+    TEST_ASSERT_EQUAL(0, UnityGetCommandLineOptions(1, perfCounters, &options));
+    TEST_ASSERT_EQUAL(0, options.Perf.EventCount);
+    TEST_ASSERT_EQUAL(0, UnityGetCommandLineOptions(3, perfCounters, &options));
+    TEST_ASSERT_EQUAL(3, options.Perf.EventCount);
+}
+
+TEST(UnityCommandOptions, OptionPerfCountersNeedsAList)
+{
+    TEST_ASSERT_EQUAL(1, UnityGetCommandLineOptions(2, perfCounters, &options));
 }
 
+static char* unknownPerfCounter[] = {
+        "testrunner.exe",
+        "--perf-counters", "cycles,cache-hits"
+};
+
+TEST(UnityCommandOptions, OptionPerfCountersRejectsAnUnknownCounter)
+{
+    TEST_ASSERT_EQUAL(1, UnityGetCommandLineOptions(3, unknownPerfCounter, &options));
+}
+#endif
 
 //------------------------------------------------------------
 
@@ -287,29 +565,19 @@ TEST_TEAR_DOWN(LeakDetection)
     UnityOutputCharSpy_Destroy();
 }
 
-#define EXPECT_ABORT_BEGIN \
-  { \
-    jmp_buf TestAbortFrame;   \
-    memcpy(TestAbortFrame, Unity.AbortFrame, sizeof(jmp_buf)); \
-    if (TEST_PROTECT()) \
-    {
-
-#define EXPECT_ABORT_END \
-    } \
-    memcpy(Unity.AbortFrame, TestAbortFrame, sizeof(jmp_buf)); \
-  }
-
 TEST(LeakDetection, DetectsLeak)
 {
     void* m = malloc(10);
+    const char* output;
     UnityOutputCharSpy_Enable(1);
-    EXPECT_ABORT_BEGIN
-    UnityMalloc_EndTest();
-    EXPECT_ABORT_END
+    UnityMalloc_EndTest(unity_p);
     UnityOutputCharSpy_Enable(0);
-    CHECK(strstr(UnityOutputCharSpy_Get(), "This test leaks!"));
+    output = UnityOutputCharSpy_Get();
+    // a test of its own again, so the block is not counted when it is freed
+    UnityMalloc_StartTest(unity_p);
     free(m);
-    Unity.CurrentTestFailed = 0;
+    unity_p->CurrentTestFailed = 0;
+    CHECK(strstr(output, "This test leaks!"));
 }
 
 TEST(LeakDetection, BufferOverrunFoundDuringFree)
@@ -318,12 +586,10 @@ TEST(LeakDetection, BufferOverrunFoundDuringFree)
     char* s = (char*)m;
     s[10] = (char)0xFF;
     UnityOutputCharSpy_Enable(1);
-    EXPECT_ABORT_BEGIN
     free(m);
-    EXPECT_ABORT_END
     UnityOutputCharSpy_Enable(0);
+    unity_p->CurrentTestFailed = 0;
     CHECK(strstr(UnityOutputCharSpy_Get(), "Buffer overrun detected during free()"));
-    Unity.CurrentTestFailed = 0;
 }
 
 TEST(LeakDetection, BufferOverrunFoundDuringRealloc)
@@ -332,10 +598,1067 @@ TEST(LeakDetection, BufferOverrunFoundDuringRealloc)
     char* s = (char*)m;
     s[10] = (char)0xFF;
     UnityOutputCharSpy_Enable(1);
-    EXPECT_ABORT_BEGIN
     m = realloc(m, 100);
-    EXPECT_ABORT_END
     UnityOutputCharSpy_Enable(0);
+    unity_p->CurrentTestFailed = 0;
+    TEST_ASSERT_POINTERS_EQUAL(0, m);
     CHECK(strstr(UnityOutputCharSpy_Get(), "Buffer overrun detected during realloc()"));
-    Unity.CurrentTestFailed = 0;
 }
+
+TEST(LeakDetection, DoubleFreeIsReported)
+{
+    void* m = malloc(10);
+    free(m);
+    UnityOutputCharSpy_Enable(1);
+    free(m);
+    UnityOutputCharSpy_Enable(0);
+    CHECK(unity_p->CurrentTestFailed);
+    unity_p->CurrentTestFailed = 0;
+    CHECK(strstr(UnityOutputCharSpy_Get(), "Double free detected"));
+}
+
+TEST(LeakDetection, ReallocOfFreedMemoryIsReported)
+{
+    void* m = malloc(10);
+    free(m);
+    UnityOutputCharSpy_Enable(1);
+    m = realloc(m, 20);
+    UnityOutputCharSpy_Enable(0);
+    CHECK(unity_p->CurrentTestFailed);
+    unity_p->CurrentTestFailed = 0;
+    TEST_ASSERT_POINTERS_EQUAL(0, m);
+    CHECK(strstr(UnityOutputCharSpy_Get(), "Freed memory passed to realloc()"));
+}
+
+// the released block is handed out again, and is then a live block like any other
+TEST(LeakDetection, ReusedBlockCanBeFreed)
+{
+    void* m = malloc(10);
+    free(m);
+    m = malloc(10);
+    free(m);
+    CHECK(!unity_p->CurrentTestFailed);
+}
+
+//------------------------------------------------------------
+
+TEST_GROUP(AllocationStats);
+
+TEST_SETUP(AllocationStats)
+{
+    UnityOutputCharSpy_Create(1000);
+}
+
+TEST_TEAR_DOWN(AllocationStats)
+{
+    UnityOutputCharSpy_Destroy();
+}
+
+static void assertMaxAllocations(unsigned long count, struct _Unity * const unity_p)
+{
+    TEST_ASSERT_MAX_ALLOCATIONS(count);
+}
+
+static void assertPeakBytes(unsigned long bytes, struct _Unity * const unity_p)
+{
+    TEST_ASSERT_PEAK_BYTES(bytes);
+}
+
+TEST(AllocationStats, CountsAllocationsBytesAndPeak)
+{
+    void* first = malloc(100);
+    void* second = malloc(50);
+    void* third;
+    const UnityAllocationStats* stats = UnityMalloc_Stats(unity_p);
+
+    free(first);
+    third = malloc(30);
+    third = realloc(third, 20);
+    TEST_ASSERT_EQUAL(3, stats->Allocations);
+    TEST_ASSERT_EQUAL(180, stats->Bytes);
+    TEST_ASSERT_EQUAL(150, stats->PeakBytes);
+    TEST_ASSERT_EQUAL(1, stats->Reallocs);
+    free(second);
+    free(third);
+    TEST_ASSERT_EQUAL(150, stats->PeakBytes);
+}
+
+TEST(AllocationStats, BudgetsPassAtTheLimit)
+{
+    void* first = malloc(100);
+    void* second = malloc(50);
+
+    free(first);
+    free(second);
+    TEST_ASSERT_MAX_ALLOCATIONS(2);
+    TEST_ASSERT_PEAK_BYTES(150);
+}
+
+TEST(AllocationStats, AllocationBudgetFailsAboveTheLimit)
+{
+    free(malloc(10));
+    free(malloc(10));
+    UnityOutputCharSpy_Enable(1);
+    assertMaxAllocations(1, unity_p);
+    UnityOutputCharSpy_Enable(0);
+    CHECK(unity_p->CurrentTestFailed);
+    unity_p->CurrentTestFailed = 0;
+    CHECK(strstr(UnityOutputCharSpy_Get(), "Expected at most 1 allocations Was 2"));
+}
+
+TEST(AllocationStats, PeakBudgetFailsAboveTheLimit)
+{
+    free(malloc(64));
+    UnityOutputCharSpy_Enable(1);
+    assertPeakBytes(63, unity_p);
+    UnityOutputCharSpy_Enable(0);
+    CHECK(unity_p->CurrentTestFailed);
+    unity_p->CurrentTestFailed = 0;
+    CHECK(strstr(UnityOutputCharSpy_Get(), "Expected at most 63 peak bytes Was 64"));
+}
+
+// a test that already failed reports its first failure only
+TEST(AllocationStats, BudgetsAreSkippedAfterAFailure)
+{
+    int failed;
+
+    free(malloc(10));
+    unity_p->CurrentTestFailed = 1;
+    UnityOutputCharSpy_Enable(1);
+    failed = UnityMalloc_AssertMaxAllocations(0, NULL, __LINE__, __FILE__, unity_p) &&
+             UnityMalloc_AssertPeakBytes(0, NULL, __LINE__, __FILE__, unity_p);
+    UnityOutputCharSpy_Enable(0);
+    unity_p->CurrentTestFailed = 0;
+    CHECK(failed);
+    TEST_ASSERT_EQUAL_STRING("", UnityOutputCharSpy_Get());
+}
+
+#if defined(UNITY_PARALLEL)
+static void* allocateOnAnotherThread(void* size)
+{
+    free(malloc(*(size_t*)size));
+    return NULL;
+}
+
+// a thread that runs no test is not counted, so a -j worker only counts the allocations of its own test
+TEST(AllocationStats, OtherThreadsAreNotCounted)
+{
+    const UnityAllocationStats* stats = UnityMalloc_Stats(unity_p);
+    size_t size = 64;
+    pthread_t other;
+
+    free(malloc(16));
+    TEST_ASSERT_EQUAL(0, pthread_create(&other, NULL, allocateOnAnotherThread, &size));
+    pthread_join(other, NULL);
+    TEST_ASSERT_EQUAL(1, stats->Allocations);
+    TEST_ASSERT_EQUAL(16, stats->Bytes);
+}
+#endif
+
+//------------------------------------------------------------
+
+TEST_GROUP(SizeClasses);
+
+TEST_SETUP(SizeClasses)
+{
+    UnityOutputCharSpy_Create(1000);
+}
+
+TEST_TEAR_DOWN(SizeClasses)
+{
+    UnityOutputCharSpy_Destroy();
+}
+
+// 10 and 20 bytes both fit the smallest class, so the block stays where it is
+TEST(SizeClasses, GrowingInPlaceKeepsTheContentsAndMovesTheEnd)
+{
+    char* m = (char*)malloc(10);
+    char* grown;
+
+    memcpy(m, "123456789", 10);
+    grown = (char*)realloc(m, 20);
+    TEST_ASSERT_POINTERS_EQUAL(m, grown);
+    TEST_ASSERT_EQUAL_STRING("123456789", grown);
+    memset(grown, 'x', 20);
+    grown[20] = (char)0xFF;
+    UnityOutputCharSpy_Enable(1);
+    free(grown);
+    UnityOutputCharSpy_Enable(0);
+    CHECK(unity_p->CurrentTestFailed);
+    unity_p->CurrentTestFailed = 0;
+    CHECK(strstr(UnityOutputCharSpy_Get(), "Buffer overrun detected during free()"));
+}
+
+TEST(SizeClasses, OverrunAfterAShrinkIsFound)
+{
+    char* m = (char*)malloc(20);
+
+    m = (char*)realloc(m, 10);
+    m[10] = (char)0xFF;
+    UnityOutputCharSpy_Enable(1);
+    free(m);
+    UnityOutputCharSpy_Enable(0);
+    CHECK(unity_p->CurrentTestFailed);
+    unity_p->CurrentTestFailed = 0;
+    CHECK(strstr(UnityOutputCharSpy_Get(), "Buffer overrun detected during free()"));
+}
+
+// from the smallest class to a block too large for any class, and on past the capacity of that one
+TEST(SizeClasses, GrowingFromAClassToALargeBlock)
+{
+    unsigned char* m = (unsigned char*)malloc(16);
+    size_t i;
+
+    for (i = 0; i < 16; i++)
+        m[i] = (unsigned char)i;
+    m = (unsigned char*)realloc(m, UNITY_MALLOC_CLASS_MAX + 1);
+    CHECK(m != NULL);
+    for (i = 0; i < 16; i++)
+        TEST_ASSERT_EQUAL_HEX8(i, m[i]);
+    m[UNITY_MALLOC_CLASS_MAX] = 0xA5;
+    m = (unsigned char*)realloc(m, 2 * UNITY_MALLOC_CLASS_MAX);
+    CHECK(m != NULL);
+    TEST_ASSERT_EQUAL_HEX8(15, m[15]);
+    TEST_ASSERT_EQUAL_HEX8(0xA5, m[UNITY_MALLOC_CLASS_MAX]);
+    m[2 * UNITY_MALLOC_CLASS_MAX - 1] = 0;
+    free(m);
+    CHECK(!unity_p->CurrentTestFailed);
+}
+
+TEST(SizeClasses, FreedBlocksArePooledUntilTheTestEnds)
+{
+    void* m = malloc(10);
+    unsigned int i;
+
+    free(m);
+    TEST_ASSERT_EQUAL(1, unity_p->Malloc.FreeCounts[0]);
+    TEST_ASSERT_POINTERS_EQUAL(m, malloc(10));
+    TEST_ASSERT_EQUAL(0, unity_p->Malloc.FreeCounts[0]);
+    free(m);
+    free(malloc(100));
+    UnityMalloc_EndTest(unity_p);
+    for (i = 0; i < UNITY_MALLOC_CLASSES; i++)
+    {
+        TEST_ASSERT_EQUAL(0, unity_p->Malloc.FreeCounts[i]);
+        TEST_ASSERT_POINTERS_EQUAL(NULL, unity_p->Malloc.FreeLists[i]);
+    }
+    UnityMalloc_StartTest(unity_p);
+}
+
+//------------------------------------------------------------
+
+TEST_GROUP(FailureInjection);
+
+TEST_SETUP(FailureInjection)
+{
+    UnityOutputCharSpy_Create(1000);
+}
+
+TEST_TEAR_DOWN(FailureInjection)
+{
+    UnityOutputCharSpy_Destroy();
+}
+
+TEST(FailureInjection, FailsOnlyTheGivenSite)
+{
+    void* failed;
+    void* other;
+
+    UnityMalloc_MakeMallocFailAtSite("unity_fixture_Test.c", __LINE__ + 1);
+    failed = malloc(10);
+    other = malloc(10);
+    TEST_ASSERT_POINTERS_EQUAL(NULL, failed);
+    CHECK(other != NULL);
+    free(other);
+}
+
+TEST(FailureInjection, ProbabilityOneFailsEverything)
+{
+    UnityMalloc_MakeMallocFailWithProbability(1.0, 1);
+    TEST_ASSERT_POINTERS_EQUAL(NULL, malloc(10));
+    TEST_ASSERT_POINTERS_EQUAL(NULL, calloc(2, 10));
+}
+
+static unsigned long failurePattern(unsigned int seed)
+{
+    unsigned long pattern = 0;
+    int i;
+
+    UnityMalloc_MakeMallocFailWithProbability(0.5, seed);
+    for (i = 0; i < 32; i++)
+    {
+        void* m = malloc(10);
+        if (m == NULL)
+            pattern |= 1ul << i;
+        free(m);
+    }
+    UnityMalloc_MakeMallocFailWithProbability(0.0, 0);
+    return pattern;
+}
+
+TEST(FailureInjection, SameSeedFailsTheSameAllocations)
+{
+    unsigned long pattern = failurePattern(42);
+
+    TEST_ASSERT_EQUAL_HEX32(pattern, failurePattern(42));
+    CHECK(pattern != 0);
+    CHECK(pattern != 0xFFFFFFFFul);
+}
+
+/* DX_PATCH: the sweep is run on a context of its own. Its tests take over the allocation
+   tracking of the thread, which is given back to the running test afterwards. */
+static void* sweepFirst;
+static void* sweepSecond;
+
+static void sweepSetup(struct _Unity * const unity_p)
+{
+    sweepFirst = NULL;
+    sweepSecond = NULL;
+}
+
+static void sweepTearDown(void * local, struct _Unity * const unity_p)
+{
+    free(sweepFirst);
+    free(sweepSecond);
+}
+
+static void sweepCleanBody(void * local, struct _Unity * const unity_p)
+{
+    sweepFirst = malloc(10);
+    sweepSecond = malloc(10);
+    CHECK(sweepFirst != NULL);
+    CHECK(sweepSecond != NULL);
+}
+
+// leaks the first block when the second allocation fails
+static void sweepLeakyBody(void * local, struct _Unity * const unity_p)
+{
+    void* first = malloc(10);
+    void* second;
+
+    if (first == NULL)
+        return;
+    second = malloc(10);
+    if (second == NULL)
+        return;
+    free(second);
+    free(first);
+}
+
+static int runSweep(unityTestfunction * body, struct _Unity * const unity_p)
+{
+    struct _Unity sweep;
+
+    memset(&sweep, 0, sizeof(sweep));
+    UnityBegin(&sweep);
+    sweep.AllocSweep = 1;
+    UnityOutputCharSpy_Enable(1);
+    UnityTestRunner(sweepSetup, body, sweepTearDown, "TEST(Sweep, Body)", "Sweep", "Body",
+                    __FILE__, __LINE__, &sweep);
+    UnityOutputCharSpy_Enable(0);
+    UnityMalloc_StartTest(unity_p);
+    return sweep.TestFailures;
+}
+
+TEST(FailureInjection, SweepPassesATestThatHandlesEveryFailure)
+{
+    TEST_ASSERT_EQUAL(0, runSweep(sweepCleanBody, unity_p));
+    CHECK(strstr(UnityOutputCharSpy_Get(), "Leaks") == NULL);
+}
+
+TEST(FailureInjection, SweepReportsTheFirstLeakingAllocation)
+{
+    TEST_ASSERT_EQUAL(1, runSweep(sweepLeakyBody, unity_p));
+    CHECK(strstr(UnityOutputCharSpy_Get(), "Leaks when allocation 2 of 2 fails (1 leaking runs)"));
+}
+
+#if defined(UNITY_GOLDEN_FILES)
+//------------------------------------------------------------
+
+TEST_GROUP(GoldenFile);
+
+static const char goldenPath[] = "golden_file_test.bin";
+
+TEST_SETUP(GoldenFile)
+{
+    UnityOutputCharSpy_Create(2000);
+}
+
+TEST_TEAR_DOWN(GoldenFile)
+{
+    unity_p->UpdateGolden = 0;
+    remove(goldenPath);
+    UnityOutputCharSpy_Destroy();
+}
+
+static void writeGoldenFile(const char* contents, size_t length)
+{
+    FILE* golden = fopen(goldenPath, "wb");
+    if (golden != NULL)
+    {
+        fwrite(contents, 1, length, golden);
+        fclose(golden);
+    }
+}
+
+static void assertMatchesGoldenFile(const char* actual, size_t length, struct _Unity * const unity_p)
+{
+    TEST_ASSERT_MATCHES_GOLDEN_FILE(goldenPath, actual, length);
+}
+
+// the failure is taken back so that the test can go on
+static int goldenFileFailed(struct _Unity * const unity_p)
+{
+    int failed = unity_p->CurrentTestFailed;
+    UnityOutputCharSpy_Enable(0);
+    unity_p->CurrentTestFailed = 0;
+    return failed;
+}
+
+TEST(GoldenFile, MatchingContentsPass)
+{
+    writeGoldenFile("golden", 6);
+    TEST_ASSERT_MATCHES_GOLDEN_FILE(goldenPath, "golden", 6);
+}
+
+TEST(GoldenFile, DifferentContentsFail)
+{
+    writeGoldenFile("golden", 6);
+    UnityOutputCharSpy_Enable(1);
+    assertMatchesGoldenFile("goLden", 6, unity_p);
+    CHECK(goldenFileFailed(unity_p));
+    CHECK(strstr(UnityOutputCharSpy_Get(), "Memory Mismatch. Byte 2 Expected 0x6C Was 0x4C"));
+}
+
+TEST(GoldenFile, DifferentSizeFails)
+{
+    writeGoldenFile("golden", 6);
+    UnityOutputCharSpy_Enable(1);
+    assertMatchesGoldenFile("gold", 4, unity_p);
+    CHECK(goldenFileFailed(unity_p));
+    CHECK(strstr(UnityOutputCharSpy_Get(), "Golden File Size Mismatch. Expected 6 Was 4: golden_file_test.bin"));
+}
+
+TEST(GoldenFile, MissingFileFails)
+{
+    UnityOutputCharSpy_Enable(1);
+    assertMatchesGoldenFile("golden", 6, unity_p);
+    CHECK(goldenFileFailed(unity_p));
+    CHECK(strstr(UnityOutputCharSpy_Get(), "Cannot Open Golden File golden_file_test.bin"));
+}
+
+TEST(GoldenFile, UpdateReplacesTheFile)
+{
+    writeGoldenFile("golden", 6);
+    unity_p->UpdateGolden = 1;
+    TEST_ASSERT_MATCHES_GOLDEN_FILE(goldenPath, "renewed!", 8);
+    unity_p->UpdateGolden = 0;
+    TEST_ASSERT_MATCHES_GOLDEN_FILE(goldenPath, "renewed!", 8);
+}
+
+TEST(GoldenFile, UpdateCreatesAMissingFile)
+{
+    unity_p->UpdateGolden = 1;
+    TEST_ASSERT_MATCHES_GOLDEN_FILE(goldenPath, "new", 3);
+    unity_p->UpdateGolden = 0;
+    TEST_ASSERT_MATCHES_GOLDEN_FILE(goldenPath, "new", 3);
+}
+
+#if defined(UNITY_PARALLEL)
+// Each updater has a context of its own, as a -j worker does
+static void* updateGoldenFileRepeatedly(void* failures)
+{
+    struct _Unity context;
+    int i;
+
+    memset(&context, 0, sizeof(context));
+    context.UpdateGolden = 1;
+    context.OutputMuted = 1;
+    for (i = 0; i < 64; i++)
+    {
+        UnityAssertMatchesGoldenFile(goldenPath, "updated", 7, NULL, __LINE__, __FILE__, &context);
+        *(int*)failures += context.CurrentTestFailed;
+        context.CurrentTestFailed = 0;
+    }
+    return NULL;
+}
+
+TEST(GoldenFile, ConcurrentUpdatesUseTheirOwnTemporaries)
+{
+    pthread_t updaters[2];
+    int failures[2] = { 0, 0 };
+    int i;
+
+    for (i = 0; i < 2; i++)
+        TEST_ASSERT_EQUAL(0, pthread_create(&updaters[i], NULL, updateGoldenFileRepeatedly, &failures[i]));
+    for (i = 0; i < 2; i++)
+        pthread_join(updaters[i], NULL);
+    TEST_ASSERT_EQUAL(0, failures[0] + failures[1]);
+    TEST_ASSERT_MATCHES_GOLDEN_FILE(goldenPath, "updated", 7);
+}
+#endif
+#endif /* UNITY_GOLDEN_FILES */
+
+#if defined(UNITY_PERF_COUNTERS)
+//------------------------------------------------------------
+
+TEST_GROUP(PerfCounters);
+
+TEST_SETUP(PerfCounters)
+{
+    UnityOutputCharSpy_Create(1000);
+}
+
+TEST_TEAR_DOWN(PerfCounters)
+{
+    UnityOutputCharSpy_Destroy();
+}
+
+TEST(PerfCounters, CountIsKeptWhenTheCounterRanAllTheTime)
+{
+    TEST_ASSERT_EQUAL_UINT32(1000, (_UU32)UnityPerf_Scale(1000, 500, 500));
+}
+
+TEST(PerfCounters, MultiplexedCountIsScaledToTheEnabledTime)
+{
+    // counted for a quarter of the time it was enabled
+    TEST_ASSERT_EQUAL_UINT32(4000, (_UU32)UnityPerf_Scale(1000, 800, 200));
+    TEST_ASSERT_EQUAL_UINT32(1500, (_UU32)UnityPerf_Scale(1000, 300, 200));
+}
+
+static void perfSetup(struct _Unity * const unity_p)
+{
+}
+
+static void perfTearDown(void * local, struct _Unity * const unity_p)
+{
+}
+
+static void perfBody(void * local, struct _Unity * const unity_p)
+{
+    volatile unsigned int sum = 0;
+    unsigned int i;
+
+    for (i = 0; i < 10000; i++)
+        sum += i;
+}
+
+// the values depend on the machine, a counter the kernel refuses reads n/a
+TEST(PerfCounters, VerboseOutputListsTheCounters)
+{
+    struct _Unity run;
+    const char* output;
+
+    memset(&run, 0, sizeof(run));
+    UnityBegin(&run);
+    run.Verbose = 1;
+    TEST_ASSERT_EQUAL(0, UnityPerf_Select("page-faults,task-clock", &run));
+    UnityOutputCharSpy_Enable(1);
+    UnityTestRunner(perfSetup, perfBody, perfTearDown, "TEST(Perf, Body)", "Perf", "Body",
+                    __FILE__, __LINE__, &run);
+    UnityOutputCharSpy_Enable(0);
+    UnityMalloc_StartTest(unity_p);
+    output = UnityOutputCharSpy_Get();
+    CHECK(strstr(output, " [page-faults "));
+    CHECK(strstr(output, ", task-clock "));
+    CHECK(strstr(output, "] PASS"));
+    TEST_ASSERT_EQUAL(0, run.TestFailures);
+}
+#endif
+
+#if defined(UNITY_BENCHMARK)
+//------------------------------------------------------------
+
+TEST_GROUP(Benchmark);
+
+TEST_SETUP(Benchmark)
+{
+    UnityOutputCharSpy_Create(1000);
+}
+
+TEST_TEAR_DOWN(Benchmark)
+{
+    UnityOutputCharSpy_Destroy();
+}
+
+static unsigned long long monotonicNs(void)
+{
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (unsigned long long)now.tv_sec * 1000000000ull + (unsigned long long)now.tv_nsec;
+}
+
+TEST(Benchmark, CalibratedTicksAgreeWithTheMonotonicClock)
+{
+    double nsPerTick, batchNs, loopNs;
+    unsigned long long startNs, startTicks, elapsedNs;
+    double tickNs;
+
+    UnityBench_Calibration(&nsPerTick, &batchNs, &loopNs);
+    CHECK(nsPerTick > 0.0);
+    startNs = monotonicNs();
+    startTicks = UnityBench_Ticks();
+    do
+    {
+        elapsedNs = monotonicNs() - startNs;
+    } while (elapsedNs < 5000000ull);
+    tickNs = (double)(UnityBench_Ticks() - startTicks) * nsPerTick;
+    TEST_ASSERT_FLOAT_WITHIN(0.05 * (double)elapsedNs, (double)elapsedNs, tickNs);
+}
+
+TEST(Benchmark, OverheadIsSubtractedFromEverySample)
+{
+    UnityBenchmark bench;
+    double nsPerTick, batchNs, loopNs;
+
+    UnityBench_Calibration(&nsPerTick, &batchNs, &loopNs);
+    CHECK(batchNs >= 0.0);
+    CHECK(loopNs >= 0.0);
+    UnityBench_Init(&bench, "Benchmark.Subtracted", unity_p);
+    bench.Calibrating = 0;
+    bench.Batches = 1;
+    bench.Iterations = 1000;
+    // a batch of 1000 iterations that took 3 ns each on top of the timer and loop
+    bench.BatchNs = batchNs + 1000.0 * (loopNs + 3.0);
+    CHECK(UnityBench_Next(&bench));
+    TEST_ASSERT_FLOAT_WITHIN(1e-6, 3.0, bench.Points[0].RealNs[0]);
+    // never negative, even when a batch was faster than the overhead
+    bench.BatchNs = 0.0;
+    CHECK(UnityBench_Next(&bench));
+    TEST_ASSERT_FLOAT_WITHIN(1e-9, 0.0, bench.Points[0].RealNs[1]);
+}
+
+TEST(Benchmark, EmptyLoopCostsNothingOnceTheOverheadIsSubtracted)
+{
+    UnityBenchmark empty;
+    UnityBenchmark * const bench = &empty;
+    double nsPerTick, batchNs, loopNs;
+
+    UnityBench_Init(&empty, "Benchmark.Empty", unity_p);
+    do
+    {
+        UNITY_BENCH_LOOP
+        {
+            UNITY_BENCH_CLOBBER();
+        }
+    } while (UnityBench_Next(&empty));
+    UnityOutputCharSpy_Enable(1);
+    UnityBench_Report(&empty);
+    UnityOutputCharSpy_Enable(0);
+    TEST_ASSERT_EQUAL(1, empty.PointCount);
+    TEST_ASSERT_EQUAL(UNITY_BENCH_REPETITIONS, empty.Points[0].SampleCount);
+    /* what is left is jitter and the alignment of this loop against the calibrated one, a few
+       ticks at most, while the timer alone costs tens of them per batch */
+    UnityBench_Calibration(&nsPerTick, &batchNs, &loopNs);
+    TEST_ASSERT_FLOAT_WITHIN(8.0 * nsPerTick, 0.0, empty.Points[0].MinNsPerOp);
+}
+
+// Runs the batches of a benchmark without a body, every batch is long enough to be a sample
+static void runBatches(UnityBenchmark * bench)
+{
+    do
+    {
+        bench->Batches++;
+        bench->BatchNs = 2.0 * UNITY_BENCH_MIN_TIME_NS;
+    } while (UnityBench_Next(bench));
+}
+
+TEST(Benchmark, RangeEndsWithHi)
+{
+    UnityBenchmark bench;
+
+    UnityBench_Init(&bench, "Benchmark.Range", unity_p);
+    UnityBench_SetRange(&bench, 8, 100, 8);
+    runBatches(&bench);
+    TEST_ASSERT_EQUAL(3, bench.PointCount);
+    TEST_ASSERT_EQUAL(8, bench.Points[0].N);
+    TEST_ASSERT_EQUAL(64, bench.Points[1].N);
+    // 512 would be past hi, which is measured instead
+    TEST_ASSERT_EQUAL(100, bench.Points[2].N);
+}
+
+TEST(Benchmark, RangeOfPowersMeasuresHiOnce)
+{
+    UnityBenchmark bench;
+
+    UnityBench_Init(&bench, "Benchmark.Powers", unity_p);
+    UnityBench_SetRange(&bench, 1, 64, 4);
+    runBatches(&bench);
+    TEST_ASSERT_EQUAL(4, bench.PointCount);
+    TEST_ASSERT_EQUAL(1, bench.Points[0].N);
+    TEST_ASSERT_EQUAL(16, bench.Points[2].N);
+    TEST_ASSERT_EQUAL(64, bench.Points[3].N);
+}
+
+// Runs samples of 1000 iterations, the first noisyBatches of them alternating between 2 and 4 ms
+static unsigned int runNoisyBatches(UnityBenchmark * bench, unsigned int noisyBatches)
+{
+    unsigned int batch = 0;
+
+    bench->Calibrating = 0;
+    bench->Iterations = 1000;
+    do
+    {
+        bench->Batches++;
+        bench->BatchNs = ((batch < noisyBatches) && (batch % 2)) ? 4e6 : 2e6;
+        batch++;
+    } while (UnityBench_Next(bench));
+    return batch;
+}
+
+TEST(Benchmark, NoisySamplesAreTakenAgainUntilTheySettle)
+{
+    struct _Unity run;
+    UnityBenchmark bench;
+
+    memset(&run, 0, sizeof(run));
+    run.BenchMaxCv = 0.05;
+    UnityBench_Init(&bench, "Benchmark.Settles", &run);
+    TEST_ASSERT_EQUAL(2 * UNITY_BENCH_REPETITIONS, runNoisyBatches(&bench, UNITY_BENCH_REPETITIONS));
+    TEST_ASSERT_EQUAL(1, bench.PointCount);
+    TEST_ASSERT_EQUAL(1, bench.Points[0].Reruns);
+    TEST_ASSERT_EQUAL(0, bench.Points[0].Unreliable);
+    TEST_ASSERT_FLOAT_WITHIN(1e-9, 0.0, bench.Points[0].Cv);
+}
+
+TEST(Benchmark, SamplesThatNeverSettleAreUnreliable)
+{
+    struct _Unity run;
+    UnityBenchmark bench;
+    unsigned int batches = (UNITY_BENCH_MAX_RERUNS + 1) * UNITY_BENCH_REPETITIONS;
+
+    memset(&run, 0, sizeof(run));
+    run.BenchMaxCv = 0.05;
+    UnityBench_Init(&bench, "Benchmark.Noisy", &run);
+    TEST_ASSERT_EQUAL(batches, runNoisyBatches(&bench, batches));
+    TEST_ASSERT_EQUAL(UNITY_BENCH_MAX_RERUNS, bench.Points[0].Reruns);
+    TEST_ASSERT_EQUAL(1, bench.Points[0].Unreliable);
+    CHECK(bench.Points[0].Cv > 0.05);
+}
+
+TEST(Benchmark, ZeroMaxCvKeepsTheFirstSamples)
+{
+    struct _Unity run;
+    UnityBenchmark bench;
+
+    memset(&run, 0, sizeof(run));
+    UnityBench_Init(&bench, "Benchmark.Unchecked", &run);
+    TEST_ASSERT_EQUAL(UNITY_BENCH_REPETITIONS, runNoisyBatches(&bench, UNITY_BENCH_REPETITIONS));
+    TEST_ASSERT_EQUAL(0, bench.Points[0].Reruns);
+    TEST_ASSERT_EQUAL(0, bench.Points[0].Unreliable);
+}
+
+// Samples of 1000 iterations that took 4 ns each, once the overhead is subtracted
+static void runFourNanosecondBatches(UnityBenchmark * bench)
+{
+    double nsPerTick, batchNs, loopNs;
+
+    UnityBench_Calibration(&nsPerTick, &batchNs, &loopNs);
+    bench->Calibrating = 0;
+    bench->Iterations = 1000;
+    do
+    {
+        bench->Batches++;
+        bench->BatchNs = batchNs + 1000.0 * (loopNs + 4.0);
+    } while (UnityBench_Next(bench));
+}
+
+TEST(Benchmark, ThroughputIsReportedPerSecond)
+{
+    struct _Unity run;
+    UnityBenchmark bench;
+    const char* output;
+
+    memset(&run, 0, sizeof(run));
+    run.Verbose = 1;
+    UnityBench_Init(&bench, "Benchmark.Throughput", &run);
+    bench.BytesPerOp = 6.0;
+    bench.ItemsPerOp = 2.0;
+    runFourNanosecondBatches(&bench);
+    UnityOutputCharSpy_Enable(1);
+    UnityBench_Report(&bench);
+    UnityOutputCharSpy_Enable(0);
+    output = UnityOutputCharSpy_Get();
+    // 6 bytes and 2 items every 4 ns
+    CHECK(strstr(output, ", 1.500 GB/s"));
+    CHECK(strstr(output, ", 500.000 Mitems/s"));
+}
+
+TEST(Benchmark, BytesAreAShareOfDramMemcpy)
+{
+    struct _Unity run;
+    UnityBenchmark bench;
+    double memcpyGbps, memsetGbps;
+
+    UnityBench_ReferenceBandwidths(&memcpyGbps, &memsetGbps);
+    CHECK(memcpyGbps > 0.0);
+    CHECK(memsetGbps > 0.0);
+    memset(&run, 0, sizeof(run));
+    run.Verbose = 1;
+    UnityBench_Init(&bench, "Benchmark.Share", &run);
+    // twice the bandwidth of the reference, as a cached input can reach
+    bench.BytesPerOp = 2.0 * 4.0 * memcpyGbps;
+    runFourNanosecondBatches(&bench);
+    UnityOutputCharSpy_Enable(1);
+    UnityBench_Report(&bench);
+    UnityOutputCharSpy_Enable(0);
+    CHECK(strstr(UnityOutputCharSpy_Get(), " GB/s = 200.000% of DRAM memcpy"));
+}
+
+TEST(Benchmark, NoThroughputWithoutBytesOrItems)
+{
+    struct _Unity run;
+    UnityBenchmark bench;
+    const char* output;
+
+    memset(&run, 0, sizeof(run));
+    run.Verbose = 1;
+    UnityBench_Init(&bench, "Benchmark.Plain", &run);
+    runFourNanosecondBatches(&bench);
+    UnityOutputCharSpy_Enable(1);
+    UnityBench_Report(&bench);
+    UnityOutputCharSpy_Enable(0);
+    output = UnityOutputCharSpy_Get();
+    CHECK(strstr(output, " 4.000 ns/op"));
+    CHECK(strstr(output, "GB/s") == NULL);
+    CHECK(strstr(output, "Mitems/s") == NULL);
+}
+
+/* A comparison of A and B that timed the given pairs, checked against a speedup of percent
+   in its own context, whose output goes to the spy */
+static void comparePairs(UnityBenchmark * bench, const double * a, const double * b, unsigned int pairs, double percent)
+{
+    static struct _Unity run;
+    unsigned int i;
+
+    memset(&run, 0, sizeof(run));
+    UnityBegin(&run);
+    run.TestFile = __FILE__;
+    UnityBench_Init(bench, "Benchmark.Compare", &run);
+    UnityBench_SetCompare(bench, "implA", "implB", percent);
+    for (i = 0; i < pairs; i++)
+    {
+        bench->Points[0].RealNs[i] = a[i];
+        bench->Points[1].RealNs[i] = b[i];
+    }
+    bench->Points[0].SampleCount = bench->Points[1].SampleCount = pairs;
+    bench->PointCount = 2;
+    UnityOutputCharSpy_Enable(1);
+    UnityBench_Report(bench);
+    UnityOutputCharSpy_Enable(0);
+}
+
+static const double timesOfA[] = { 100.0, 100.0, 100.0, 100.0, 100.0 };
+static const double halfTimesOfA[] = { 50.0, 50.0, 50.0, 50.0, 50.0 };
+
+TEST(Benchmark, CompareRatioIsTheGeometricMeanOfThePairs)
+{
+    UnityBenchmark bench;
+    static const double b[] = { 40.0, 50.0, 62.5 };
+
+    comparePairs(&bench, timesOfA, b, 3, 0.0);
+    TEST_ASSERT_EQUAL(3, bench.RatioPairs);
+    TEST_ASSERT_FLOAT_WITHIN(1e-9, 0.5, bench.Ratio);
+    // exp(mean -+ t(2) * s / sqrt(3)) of the logarithms of 0.4, 0.5 and 0.625
+    TEST_ASSERT_FLOAT_WITHIN(1e-6, 0.2872187, bench.RatioLow);
+    TEST_ASSERT_FLOAT_WITHIN(1e-6, 0.8704168, bench.RatioHigh);
+}
+
+TEST(Benchmark, CompareRatioSkipsPairsWithoutAMeasurableTime)
+{
+    UnityBenchmark bench;
+    static const double a[] = { 100.0, 0.0, 100.0 };
+    static const double b[] = { 50.0, 50.0, 0.0 };
+
+    comparePairs(&bench, a, b, 3, 0.0);
+    TEST_ASSERT_EQUAL(1, bench.RatioPairs);
+    TEST_ASSERT_FLOAT_WITHIN(1e-9, 0.5, bench.Ratio);
+}
+
+TEST(Benchmark, SpeedupWithinTheIntervalPasses)
+{
+    UnityBenchmark bench;
+
+    comparePairs(&bench, timesOfA, halfTimesOfA, 5, 30.0);
+    TEST_ASSERT_FLOAT_WITHIN(1e-9, 0.5, bench.RatioHigh);
+    TEST_ASSERT_EQUAL(0, bench.Unity->CurrentTestFailed);
+}
+
+TEST(Benchmark, SpeedupOutsideTheIntervalFails)
+{
+    UnityBenchmark bench;
+
+    comparePairs(&bench, timesOfA, halfTimesOfA, 5, 60.0);
+    TEST_ASSERT_EQUAL(1, bench.Unity->CurrentTestFailed);
+    CHECK(strstr(UnityOutputCharSpy_Get(), "Expected implB at least 60% faster than implA"));
+}
+
+TEST(Benchmark, SpeedupNeedsTwoPairs)
+{
+    UnityBenchmark bench;
+
+    comparePairs(&bench, timesOfA, halfTimesOfA, 1, 30.0);
+    TEST_ASSERT_EQUAL(1, bench.Unity->CurrentTestFailed);
+    CHECK(strstr(UnityOutputCharSpy_Get(), "Only 1 of the pairs had a measurable time"));
+}
+
+static unsigned char rotatedInput[3000];
+
+// A benchmark that rotates rotatedInput through copies, its first batch started and stopped
+static void startRotating(UnityBenchmark * bench, struct _Unity * run, const unsigned char ** input, unsigned int copies)
+{
+    memset(run, 0, sizeof(*run));
+    UnityBench_Init(bench, "Benchmark.Rotate", run);
+    bench->CacheMode = UNITY_BENCH_ROTATE;
+    bench->Copies = copies;
+    memset(rotatedInput, 0x5A, sizeof(rotatedInput));
+    *input = rotatedInput;
+    UnityBench_SetInput(bench, (void *)input, sizeof(rotatedInput));
+    UnityBench_Start(bench);
+    UnityBench_Stop(bench);
+}
+
+TEST(Benchmark, RotateCopiesFillTheReferenceBytes)
+{
+    struct _Unity run;
+    UnityBenchmark bench;
+    const unsigned char * input;
+    size_t stride;
+
+    startRotating(&bench, &run, &input, 0);
+    TEST_ASSERT_EQUAL(UNITY_BENCH_ROTATE, bench.CacheMode);
+    // every copy starts a page of its own
+    stride = bench.CopyStride;
+    CHECK(stride >= sizeof(rotatedInput));
+    TEST_ASSERT_EQUAL(0, stride % 4096);
+    TEST_ASSERT_EQUAL((UNITY_BENCH_REFERENCE_BYTES + stride - 1) / stride, bench.CopyCount);
+    TEST_ASSERT_EQUAL_MEMORY(rotatedInput, bench.CopyBuffer, sizeof(rotatedInput));
+    TEST_ASSERT_EQUAL_MEMORY(rotatedInput, bench.CopyBuffer + (bench.CopyCount - 1) * stride, sizeof(rotatedInput));
+    UnityBench_Report(&bench);
+    TEST_ASSERT_POINTERS_EQUAL(NULL, bench.CopyBuffer);
+}
+
+TEST(Benchmark, RotateVisitsTheCopiesInAShuffledOrder)
+{
+    struct _Unity run;
+    UnityBenchmark bench;
+    const unsigned char * input;
+    unsigned char seen[64];
+    unsigned int i, inOrder = 1;
+
+    startRotating(&bench, &run, &input, 64);
+    TEST_ASSERT_EQUAL(64, bench.CopyCount);
+    memset(seen, 0, sizeof(seen));
+    for (i = 0; i < 64; i++)
+    {
+        UnityBench_Prepare(&bench);
+        TEST_ASSERT_POINTERS_EQUAL(bench.CopyBuffer + bench.CopyOrder[i] * bench.CopyStride, input);
+        TEST_ASSERT_EQUAL(0, seen[bench.CopyOrder[i]]);
+        seen[bench.CopyOrder[i]] = 1;
+        if (bench.CopyOrder[i] != i)
+            inOrder = 0;
+    }
+    // 1 in 64! to be in address order by chance
+    TEST_ASSERT_EQUAL(0, inOrder);
+    // and then the walk starts over
+    UnityBench_Prepare(&bench);
+    TEST_ASSERT_POINTERS_EQUAL(bench.CopyBuffer + bench.CopyOrder[0] * bench.CopyStride, input);
+    UnityBench_Report(&bench);
+}
+
+#define LN_10 2.302585092994045684
+
+/* Points of N = 10, 100, ... 100000 that take exactly coefficient * f(N) real time and half of
+   that in CPU time, the class f numbered as in bench->Complexity */
+static void fitPoints(UnityBenchmark * bench, int complexity, double coefficient)
+{
+    unsigned int k;
+
+    memset(bench, 0, sizeof(*bench));
+    for (k = 1; k <= 5; k++)
+    {
+        double n = (k == 1) ? 10.0 : 10.0 * (double)bench->Points[k - 2].N;
+        double ln = (double)k * LN_10;
+        double f = (complexity == 1) ? ln : (complexity == 2) ? n : (complexity == 3) ? n * ln : n * n;
+
+        bench->Points[k - 1].N = (unsigned long)n;
+        bench->Points[k - 1].NsPerOp = coefficient * f;
+        bench->Points[k - 1].CpuNsPerOp = 0.5 * coefficient * f;
+    }
+    bench->PointCount = 5;
+}
+
+// The logarithm is checked along with the fit, against the exact ln of powers of ten
+TEST(Benchmark, FitFindsLogarithmicTime)
+{
+    UnityBenchmark bench;
+
+    fitPoints(&bench, 1, 5.0);
+    UnityBench_FitComplexity(&bench);
+    TEST_ASSERT_EQUAL(1, bench.Complexity);
+    TEST_ASSERT_FLOAT_WITHIN(1e-9, 5.0, bench.ComplexityCoefficient);
+    TEST_ASSERT_FLOAT_WITHIN(1e-9, 0.5 * 5.0, bench.ComplexityCpuCoefficient);
+    TEST_ASSERT_FLOAT_WITHIN(1e-9, 0.0, bench.ComplexityRms);
+}
+
+TEST(Benchmark, FitFindsLinearTime)
+{
+    UnityBenchmark bench;
+
+    fitPoints(&bench, 2, 3.0);
+    UnityBench_FitComplexity(&bench);
+    TEST_ASSERT_EQUAL(2, bench.Complexity);
+    TEST_ASSERT_FLOAT_WITHIN(1e-9, 3.0, bench.ComplexityCoefficient);
+    TEST_ASSERT_FLOAT_WITHIN(1e-9, 0.5 * 3.0, bench.ComplexityCpuCoefficient);
+    TEST_ASSERT_FLOAT_WITHIN(1e-9, 0.0, bench.ComplexityRms);
+}
+
+TEST(Benchmark, FitFindsLinearithmicTime)
+{
+    UnityBenchmark bench;
+
+    fitPoints(&bench, 3, 0.5);
+    UnityBench_FitComplexity(&bench);
+    TEST_ASSERT_EQUAL(3, bench.Complexity);
+    TEST_ASSERT_FLOAT_WITHIN(1e-9, 0.5, bench.ComplexityCoefficient);
+    TEST_ASSERT_FLOAT_WITHIN(1e-9, 0.5 * 0.5, bench.ComplexityCpuCoefficient);
+    TEST_ASSERT_FLOAT_WITHIN(1e-9, 0.0, bench.ComplexityRms);
+}
+
+TEST(Benchmark, FitFindsQuadraticTime)
+{
+    UnityBenchmark bench;
+
+    fitPoints(&bench, 4, 0.01);
+    UnityBench_FitComplexity(&bench);
+    TEST_ASSERT_EQUAL(4, bench.Complexity);
+    TEST_ASSERT_FLOAT_WITHIN(1e-9, 0.01, bench.ComplexityCoefficient);
+    TEST_ASSERT_FLOAT_WITHIN(1e-9, 0.5 * 0.01, bench.ComplexityCpuCoefficient);
+    TEST_ASSERT_FLOAT_WITHIN(1e-9, 0.0, bench.ComplexityRms);
+}
+
+#if defined(UNITY_PERF_COUNTERS)
+TEST(Benchmark, CountersAreReportedPerIteration)
+{
+    struct _Unity run;
+    UnityBenchmark bench;
+
+    memset(&run, 0, sizeof(run));
+    run.Verbose = 1;
+    UnityBench_Init(&bench, "Benchmark.Counters", &run);
+    bench.Perf.EventCount = 1;
+    bench.Perf.Name[0] = "instructions";
+    bench.Perf.Valid[0] = 1;
+    bench.Calibrating = 0;
+    bench.Iterations = 1000;
+    // summed over all samples of 1000 iterations
+    bench.Points[0].CountersPerOp[0] = 3000.0 * UNITY_BENCH_REPETITIONS;
+    runBatches(&bench);
+    UnityOutputCharSpy_Enable(1);
+    UnityBench_Report(&bench);
+    UnityOutputCharSpy_Enable(0);
+    CHECK(strstr(UnityOutputCharSpy_Get(), " [instructions 3.000/op]"));
+}
+#endif
+#endif
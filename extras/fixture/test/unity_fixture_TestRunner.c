@@ -18,6 +18,9 @@ TEST_GROUP_RUNNER(UnityFixture)
     RUN_TEST_CASE(UnityFixture, ReallocSizeZeroFreesMemAndReturnsNullPointer);
     RUN_TEST_CASE(UnityFixture, CallocFillsWithZero);
     RUN_TEST_CASE(UnityFixture, PointerSet);
+    RUN_TEST_CASE(UnityFixture, ValueSetTakesALiteral);
+    RUN_TEST_CASE(UnityFixture, ValueSetWidensANarrowerValue);
+    RUN_TEST_CASE(UnityFixture, ValueSetRestoresInReverseOrder);
 }
 
 TEST_GROUP_RUNNER(UnityCommandOptions)
@@ -31,6 +34,33 @@ TEST_GROUP_RUNNER(UnityCommandOptions)
     RUN_TEST_CASE(UnityCommandOptions, MultipleOptions);
     RUN_TEST_CASE(UnityCommandOptions, MultipleOptionsDashRNotLastAndNoValueSpecified);
     RUN_TEST_CASE(UnityCommandOptions, UnknownCommandIsIgnored);
+    RUN_TEST_CASE(UnityCommandOptions, OptionRepeatTest);
+    RUN_TEST_CASE(UnityCommandOptions, OptionRepeatTestNeedsACount);
+    RUN_TEST_CASE(UnityCommandOptions, OptionUntilFail);
+    RUN_TEST_CASE(UnityCommandOptions, OptionUntilFailWithRepeatTestLimit);
+    RUN_TEST_CASE(UnityCommandOptions, OptionJobs);
+    RUN_TEST_CASE(UnityCommandOptions, OptionJobsNeedsACount);
+    RUN_TEST_CASE(UnityCommandOptions, OptionOrderedOutput);
+    RUN_TEST_CASE(UnityCommandOptions, OptionUpdateGolden);
+    RUN_TEST_CASE(UnityCommandOptions, OptionAllocSweep);
+    RUN_TEST_CASE(UnityCommandOptions, OptionAllMismatches);
+    RUN_TEST_CASE(UnityCommandOptions, OptionRecordDigests);
+#if defined(UNITY_BENCHMARK)
+    RUN_TEST_CASE(UnityCommandOptions, OptionBenchmarkOut);
+    RUN_TEST_CASE(UnityCommandOptions, OptionBenchmarkOutNeedsAFile);
+    RUN_TEST_CASE(UnityCommandOptions, OptionPinCpu);
+    RUN_TEST_CASE(UnityCommandOptions, OptionPinCpuNeedsANumber);
+    RUN_TEST_CASE(UnityCommandOptions, OptionPinCpuRejectsJobs);
+    RUN_TEST_CASE(UnityCommandOptions, OptionMaxCv);
+    RUN_TEST_CASE(UnityCommandOptions, OptionMaxCvNeedsAPercentage);
+    RUN_TEST_CASE(UnityCommandOptions, OptionCacheMode);
+    RUN_TEST_CASE(UnityCommandOptions, OptionCacheModeRejectsAnUnknownMode);
+#endif
+#if defined(UNITY_PERF_COUNTERS)
+    RUN_TEST_CASE(UnityCommandOptions, OptionPerfCounters);
+    RUN_TEST_CASE(UnityCommandOptions, OptionPerfCountersNeedsAList);
+    RUN_TEST_CASE(UnityCommandOptions, OptionPerfCountersRejectsAnUnknownCounter);
+#endif
 }
 
 TEST_GROUP_RUNNER(LeakDetection)
@@ -38,4 +68,142 @@ TEST_GROUP_RUNNER(LeakDetection)
     RUN_TEST_CASE(LeakDetection, DetectsLeak);
     RUN_TEST_CASE(LeakDetection, BufferOverrunFoundDuringFree);
     RUN_TEST_CASE(LeakDetection, BufferOverrunFoundDuringRealloc);
+    RUN_TEST_CASE(LeakDetection, DoubleFreeIsReported);
+    RUN_TEST_CASE(LeakDetection, ReallocOfFreedMemoryIsReported);
+    RUN_TEST_CASE(LeakDetection, ReusedBlockCanBeFreed);
+}
+
+TEST_GROUP_RUNNER(AllocationStats)
+{
+    RUN_TEST_CASE(AllocationStats, CountsAllocationsBytesAndPeak);
+    RUN_TEST_CASE(AllocationStats, BudgetsPassAtTheLimit);
+    RUN_TEST_CASE(AllocationStats, AllocationBudgetFailsAboveTheLimit);
+    RUN_TEST_CASE(AllocationStats, PeakBudgetFailsAboveTheLimit);
+    RUN_TEST_CASE(AllocationStats, BudgetsAreSkippedAfterAFailure);
+#if defined(UNITY_PARALLEL)
+    RUN_TEST_CASE(AllocationStats, OtherThreadsAreNotCounted);
+#endif
+}
+
+TEST_GROUP_RUNNER(SizeClasses)
+{
+    RUN_TEST_CASE(SizeClasses, GrowingInPlaceKeepsTheContentsAndMovesTheEnd);
+    RUN_TEST_CASE(SizeClasses, OverrunAfterAShrinkIsFound);
+    RUN_TEST_CASE(SizeClasses, GrowingFromAClassToALargeBlock);
+    RUN_TEST_CASE(SizeClasses, FreedBlocksArePooledUntilTheTestEnds);
+}
+
+TEST_GROUP_RUNNER(FailureInjection)
+{
+    RUN_TEST_CASE(FailureInjection, FailsOnlyTheGivenSite);
+    RUN_TEST_CASE(FailureInjection, ProbabilityOneFailsEverything);
+    RUN_TEST_CASE(FailureInjection, SameSeedFailsTheSameAllocations);
+    RUN_TEST_CASE(FailureInjection, SweepPassesATestThatHandlesEveryFailure);
+    RUN_TEST_CASE(FailureInjection, SweepReportsTheFirstLeakingAllocation);
+}
+
+#if defined(UNITY_GOLDEN_FILES)
+TEST_GROUP_RUNNER(GoldenFile)
+{
+    RUN_TEST_CASE(GoldenFile, MatchingContentsPass);
+    RUN_TEST_CASE(GoldenFile, DifferentContentsFail);
+    RUN_TEST_CASE(GoldenFile, DifferentSizeFails);
+    RUN_TEST_CASE(GoldenFile, MissingFileFails);
+    RUN_TEST_CASE(GoldenFile, UpdateReplacesTheFile);
+    RUN_TEST_CASE(GoldenFile, UpdateCreatesAMissingFile);
+#if defined(UNITY_PARALLEL)
+    RUN_TEST_CASE(GoldenFile, ConcurrentUpdatesUseTheirOwnTemporaries);
+#endif
+}
+#endif
+
+#if defined(UNITY_PERF_COUNTERS)
+TEST_GROUP_RUNNER(PerfCounters)
+{
+    RUN_TEST_CASE(PerfCounters, CountIsKeptWhenTheCounterRanAllTheTime);
+    RUN_TEST_CASE(PerfCounters, MultiplexedCountIsScaledToTheEnabledTime);
+    RUN_TEST_CASE(PerfCounters, VerboseOutputListsTheCounters);
+}
+#endif
+
+#if defined(UNITY_BENCHMARK)
+TEST_GROUP_RUNNER(Benchmark)
+{
+    RUN_TEST_CASE(Benchmark, CalibratedTicksAgreeWithTheMonotonicClock);
+    RUN_TEST_CASE(Benchmark, OverheadIsSubtractedFromEverySample);
+    RUN_TEST_CASE(Benchmark, EmptyLoopCostsNothingOnceTheOverheadIsSubtracted);
+    RUN_TEST_CASE(Benchmark, RangeEndsWithHi);
+    RUN_TEST_CASE(Benchmark, RangeOfPowersMeasuresHiOnce);
+    RUN_TEST_CASE(Benchmark, NoisySamplesAreTakenAgainUntilTheySettle);
+    RUN_TEST_CASE(Benchmark, SamplesThatNeverSettleAreUnreliable);
+    RUN_TEST_CASE(Benchmark, ZeroMaxCvKeepsTheFirstSamples);
+    RUN_TEST_CASE(Benchmark, ThroughputIsReportedPerSecond);
+    RUN_TEST_CASE(Benchmark, BytesAreAShareOfDramMemcpy);
+    RUN_TEST_CASE(Benchmark, NoThroughputWithoutBytesOrItems);
+    RUN_TEST_CASE(Benchmark, CompareRatioIsTheGeometricMeanOfThePairs);
+    RUN_TEST_CASE(Benchmark, CompareRatioSkipsPairsWithoutAMeasurableTime);
+    RUN_TEST_CASE(Benchmark, SpeedupWithinTheIntervalPasses);
+    RUN_TEST_CASE(Benchmark, SpeedupOutsideTheIntervalFails);
+    RUN_TEST_CASE(Benchmark, SpeedupNeedsTwoPairs);
+    RUN_TEST_CASE(Benchmark, RotateCopiesFillTheReferenceBytes);
+    RUN_TEST_CASE(Benchmark, RotateVisitsTheCopiesInAShuffledOrder);
+    RUN_TEST_CASE(Benchmark, FitFindsLogarithmicTime);
+    RUN_TEST_CASE(Benchmark, FitFindsLinearTime);
+    RUN_TEST_CASE(Benchmark, FitFindsLinearithmicTime);
+    RUN_TEST_CASE(Benchmark, FitFindsQuadraticTime);
+#if defined(UNITY_PERF_COUNTERS)
+    RUN_TEST_CASE(Benchmark, CountersAreReportedPerIteration);
+#endif
+}
+#endif
+
+TEST_GROUP_RUNNER(UnityMismatchReport)
+{
+    RUN_TEST_CASE(UnityMismatchReport, FirstMismatchOfAnIntArray);
+    RUN_TEST_CASE(UnityMismatchReport, EqualArrayReportsNothing);
+    RUN_TEST_CASE(UnityMismatchReport, FirstMismatchOfAMemoryArray);
+    RUN_TEST_CASE(UnityMismatchReport, StringMismatch);
+    RUN_TEST_CASE(UnityMismatchReport, NumberMismatchKeepsTheMessage);
+    RUN_TEST_CASE(UnityMismatchReport, AllMismatchesOfAnIntArray);
+    RUN_TEST_CASE(UnityMismatchReport, AllMismatchesOfAMemoryArray);
+    RUN_TEST_CASE(UnityMismatchReport, RangesAreCappedAtTheReportLimit);
+}
+
+TEST_GROUP_RUNNER(UnityMemoryDiff)
+{
+    RUN_TEST_CASE(UnityMemoryDiff, RowsAroundTheMismatch);
+    RUN_TEST_CASE(UnityMemoryDiff, ShortLastRow);
+    RUN_TEST_CASE(UnityMemoryDiff, DumpFollowsTheMessage);
+}
+
+TEST_GROUP_RUNNER(UnityStreamCompare)
+{
+    RUN_TEST_CASE(UnityStreamCompare, ChunksOfDifferentSizesMatch);
+    RUN_TEST_CASE(UnityStreamCompare, MismatchReportsTheStreamOffset);
+    RUN_TEST_CASE(UnityStreamCompare, ShorterStreamFailsAtTheEnd);
+}
+
+TEST_GROUP_RUNNER(UnityUlps)
+{
+    RUN_TEST_CASE(UnityUlps, NeighbouringFloatsAreOneUlpApart);
+    RUN_TEST_CASE(UnityUlps, FloatKeysAreContinuousAcrossZero);
+    RUN_TEST_CASE(UnityUlps, FloatNaNNeverMatches);
+    RUN_TEST_CASE(UnityUlps, FloatArrayReportsTheFailingElement);
+    RUN_TEST_CASE(UnityUlps, DoubleKeysAreContinuousAcrossZero);
+}
+
+TEST_GROUP_RUNNER(UnityDigest)
+{
+    RUN_TEST_CASE(UnityDigest, KnownDigests);
+    RUN_TEST_CASE(UnityDigest, LongUnalignedInput);
+    RUN_TEST_CASE(UnityDigest, MismatchShowsBothDigests);
+    RUN_TEST_CASE(UnityDigest, RecordModePrintsTheDigestAndPasses);
+}
+
+TEST_GROUP_RUNNER(UnityMemoryCompare)
+{
+    RUN_TEST_CASE(UnityMemoryCompare, SmallMismatchIsFound);
+    RUN_TEST_CASE(UnityMemoryCompare, ParallelCompareOfEqualBuffersPasses);
+    RUN_TEST_CASE(UnityMemoryCompare, ParallelCompareReportsTheFirstMismatch);
+    RUN_TEST_CASE(UnityMemoryCompare, MismatchPast4GiBIsFound);
 }
@@ -8,6 +8,10 @@
 #include <stdio.h>
 #include <string.h>
 #include <math.h>
+#if defined(UNITY_PARALLEL)
+#include <stdlib.h>
+#include <pthread.h>
+#endif
 
 // VS issues a bogus warning in release builds for INFINITY. Sad.
 #if defined(_MSC_VER)
@@ -15,11 +19,11 @@
 #endif // _MSC_VER
 
 /* DX_PATCH: jumpless version "longjmp(unity_p->AbortFrame" removed, return added*/
-#define UNITY_FAIL_AND_BAIL   { unity_p->CurrentTestFailed  = 1; UNITY_OUTPUT_CHAR('\n'); return 1; }
-#define UNITY_IGNORE_AND_BAIL { unity_p->CurrentTestIgnored = 1; UNITY_OUTPUT_CHAR('\n'); return 1; }
+#define UNITY_FAIL_AND_BAIL   { unity_p->CurrentTestFailed  = 1; UNITY_PRINT_CHAR('\n', unity_p); return 1; }
+#define UNITY_IGNORE_AND_BAIL { unity_p->CurrentTestIgnored = 1; UNITY_PRINT_CHAR('\n', unity_p); return 1; }
 /// return prematurely if we are already in failure or ignore state
 #define UNITY_SKIP_EXECUTION  { if ((unity_p->CurrentTestFailed != 0) || (unity_p->CurrentTestIgnored != 0)) {return 1;} }
-#define UNITY_PRINT_EOL       { UNITY_OUTPUT_CHAR('\n'); }
+#define UNITY_PRINT_EOL       { UNITY_PRINT_CHAR('\n', unity_p); }
 
 static const char* UnityStrNull     = "NULL";
 static const char* UnityStrSpacer   = ". ";
@@ -29,13 +33,20 @@ static const char* UnityStrTo       = " To ";
 static const char* UnityStrElement  = " Element ";
 static const char* UnityStrByte     = " Byte ";
 static const char* UnityStrMemory   = " Memory Mismatch.";
+static const char* UnityStrStream   = " Stream Mismatch.";
+static const char* UnityStrDigest   = " Digest Mismatch.";
+static const char* UnityStrStreamLength = " Stream Length Mismatch.";
 static const char* UnityStrDelta    = " Values Not Within Delta ";
+static const char* UnityStrUlpsApart= " ULPs Apart, Allowed ";
+static const char* UnityStrUlpsNaN  = " Values Not Comparable (NaN)";
 static const char* UnityStrPointless= " You Asked Me To Compare Nothing, Which Was Pointless.";
 static const char* UnityStrNullPointerForExpected= " Expected pointer to be NULL";
 static const char* UnityStrNullPointerForActual  = " Actual pointer was NULL";
 static const char* UnityStrInf      = "Infinity";
 static const char* UnityStrNegInf   = "Negative Infinity";
 static const char* UnityStrNaN      = "NaN";
+static const char* UnityStrMismatchedElements = " Mismatched Elements: ";
+static const char* UnityStrMismatchedBytes    = " Mismatched Bytes: ";
 
 #ifndef UNITY_EXCLUDE_FLOAT
 // Dividing by these constants produces +/- infinity.
@@ -53,6 +64,36 @@ void UnityPrintOk(struct _Unity * const unity_p);
 // Pretty Printers & Test Result Output Handlers
 //-----------------------------------------------
 
+#if defined(UNITY_PARALLEL)
+/* DX_PATCH: append to the capture buffer of the running test; fails only when out of memory */
+static int UnityCaptureChar(const char ch, struct _UnityOutputBuffer * const buffer)
+{
+    if (buffer->Length == buffer->Capacity)
+    {
+        unsigned long capacity = (buffer->Capacity == 0) ? 256 : buffer->Capacity * 2;
+        char * data = (char*)UNITY_INTERNAL_REALLOC(buffer->Data, capacity);
+        if (data == NULL)
+            return 0;
+        buffer->Data = data;
+        buffer->Capacity = capacity;
+    }
+    buffer->Data[buffer->Length++] = ch;
+    return 1;
+}
+#endif
+
+void UnityPrintChar(const char ch, struct _Unity * const unity_p)
+{
+    if (unity_p->OutputMuted)
+        return;
+#if defined(UNITY_PARALLEL)
+    if ((unity_p->Capture != NULL) && UnityCaptureChar(ch, unity_p->Capture))
+        return;
+#endif
+    UNITY_OUTPUT_CHAR(ch);
+}
+
+//-----------------------------------------------
 void UnityPrint(const char* string, struct _Unity * const unity_p)
 {
     const char* pch = string;
@@ -64,24 +105,24 @@ void UnityPrint(const char* string, struct _Unity * const unity_p)
             // printable characters plus CR & LF are printed
             if ((*pch <= 126) && (*pch >= 32))
             {
-                UNITY_OUTPUT_CHAR(*pch);
+                UNITY_PRINT_CHAR(*pch, unity_p);
             }
             //write escaped carriage returns
             else if (*pch == 13)
             {
-                UNITY_OUTPUT_CHAR('\\');
-                UNITY_OUTPUT_CHAR('r');
+                UNITY_PRINT_CHAR('\\', unity_p);
+                UNITY_PRINT_CHAR('r', unity_p);
             }
             //write escaped line feeds
             else if (*pch == 10)
             {
-                UNITY_OUTPUT_CHAR('\\');
-                UNITY_OUTPUT_CHAR('n');
+                UNITY_PRINT_CHAR('\\', unity_p);
+                UNITY_PRINT_CHAR('n', unity_p);
             }
             // unprintable characters are shown as codes
             else
             {
-                UNITY_OUTPUT_CHAR('\\');
+                UNITY_PRINT_CHAR('\\', unity_p);
                 UnityPrintNumberHex((_U_SINT)*pch, 2, unity_p);
             }
             pch++;
@@ -133,7 +174,7 @@ void UnityPrintNumber(const _U_SINT number_to_print, struct _Unity * const unity
 
     if (number < 0)
     {
-        UNITY_OUTPUT_CHAR('-');
+        UNITY_PRINT_CHAR('-', unity_p);
         number = -number;
     }
 
@@ -150,7 +191,7 @@ void UnityPrintNumber(const _U_SINT number_to_print, struct _Unity * const unity
     // now mod and print, then divide divisor
     do
     {
-        UNITY_OUTPUT_CHAR((char)('0' + (number / divisor % 10)));
+        UNITY_PRINT_CHAR((char)('0' + (number / divisor % 10)), unity_p);
         divisor /= 10;
     }
     while (divisor > 0);
@@ -176,7 +217,7 @@ void UnityPrintNumberUnsigned(const _U_UINT number, struct _Unity * const unity_
     // now mod and print, then divide divisor
     do
     {
-        UNITY_OUTPUT_CHAR((char)('0' + (number / divisor % 10)));
+        UNITY_PRINT_CHAR((char)('0' + (number / divisor % 10)), unity_p);
         divisor /= 10;
     }
     while (divisor > 0);
@@ -187,19 +228,19 @@ void UnityPrintNumberHex(const _U_UINT number, const char nibbles_to_print, stru
 {
     _U_UINT nibble;
     char nibbles = nibbles_to_print;
-    UNITY_OUTPUT_CHAR('0');
-    UNITY_OUTPUT_CHAR('x');
+    UNITY_PRINT_CHAR('0', unity_p);
+    UNITY_PRINT_CHAR('x', unity_p);
 
     while (nibbles > 0)
     {
         nibble = (number >> (--nibbles << 2)) & 0x0000000F;
         if (nibble <= 9)
         {
-            UNITY_OUTPUT_CHAR((char)('0' + nibble));
+            UNITY_PRINT_CHAR((char)('0' + nibble), unity_p);
         }
         else
         {
-            UNITY_OUTPUT_CHAR((char)('A' - 10 + nibble));
+            UNITY_PRINT_CHAR((char)('A' - 10 + nibble), unity_p);
         }
     }
 }
@@ -216,16 +257,16 @@ void UnityPrintMask(const _U_UINT mask, const _U_UINT number, struct _Unity * co
         {
             if (current_bit & number)
             {
-                UNITY_OUTPUT_CHAR('1');
+                UNITY_PRINT_CHAR('1', unity_p);
             }
             else
             {
-                UNITY_OUTPUT_CHAR('0');
+                UNITY_PRINT_CHAR('0', unity_p);
             }
         }
         else
         {
-            UNITY_OUTPUT_CHAR('X');
+            UNITY_PRINT_CHAR('X', unity_p);
         }
         current_bit = current_bit >> 1;
     }
@@ -259,11 +300,11 @@ static void UnityTestResultsBegin(const char* file, const UNITY_LINE_TYPE line,
 {
     UNITY_PRINT_EOL;
     UnityPrint(file, unity_p);
-    UNITY_OUTPUT_CHAR(':');
+    UNITY_PRINT_CHAR(':', unity_p);
     UnityPrintNumber(line, unity_p);
-    UNITY_OUTPUT_CHAR(':');
+    UNITY_PRINT_CHAR(':', unity_p);
     UnityPrint(unity_p->CurrentTestName, unity_p);
-    UNITY_OUTPUT_CHAR(':');
+    UNITY_PRINT_CHAR(':', unity_p);
 }
 
 //-----------------------------------------------
@@ -314,9 +355,9 @@ static void UnityPrintExpectedAndActualStrings(const char* expected, const char*
     UnityPrint(UnityStrExpected, unity_p);
     if (expected != NULL)
     {
-        UNITY_OUTPUT_CHAR('\'');
+        UNITY_PRINT_CHAR('\'', unity_p);
         UnityPrint(expected, unity_p);
-        UNITY_OUTPUT_CHAR('\'');
+        UNITY_PRINT_CHAR('\'', unity_p);
     }
     else
     {
@@ -325,9 +366,9 @@ static void UnityPrintExpectedAndActualStrings(const char* expected, const char*
     UnityPrint(UnityStrWas, unity_p);
     if (actual != NULL)
     {
-        UNITY_OUTPUT_CHAR('\'');
+        UNITY_PRINT_CHAR('\'', unity_p);
         UnityPrint(actual, unity_p);
-        UNITY_OUTPUT_CHAR('\'');
+        UNITY_PRINT_CHAR('\'', unity_p);
     }
     else
     {
@@ -335,6 +376,533 @@ static void UnityPrintExpectedAndActualStrings(const char* expected, const char*
     }
 }
 
+//-----------------------------------------------
+// Failure Reporting
+//-----------------------------------------------
+
+/* DX_PATCH: the assertion functions below only detect a failure and describe it in a
+   UnityMismatch. All the formatting lives in the out-of-line UnityReportMismatch, so each
+   comparison loop stays small and has a single, rarely taken exit to the reporter. */
+typedef enum
+{
+    UNITY_MISMATCH_TEXT,
+    UNITY_MISMATCH_NUMBER,
+    UNITY_MISMATCH_BITS,
+    UNITY_MISMATCH_DELTA,
+    UNITY_MISMATCH_MEMORY,
+    UNITY_MISMATCH_FLOAT,
+    UNITY_MISMATCH_STRING,
+    UNITY_MISMATCH_STREAM,
+    UNITY_MISMATCH_STREAM_LENGTH,
+    UNITY_MISMATCH_ULPS,
+    UNITY_MISMATCH_DIGEST
+} UNITY_MISMATCH_KIND_T;
+
+#define UNITY_NO_ELEMENT ((_UU32)-1)
+
+/// all mismatches of an array, kept as merged index ranges (see ReportAllMismatches)
+typedef struct _UnityMismatchSummary
+{
+    size_t count;
+    _UU32 rangeCount;
+    size_t first[UNITY_MISMATCH_REPORT_LIMIT];
+    size_t last[UNITY_MISMATCH_REPORT_LIMIT];
+    int truncated;
+} UnityMismatchSummary;
+
+typedef struct _UnityMismatch
+{
+    UNITY_MISMATCH_KIND_T kind;
+    UNITY_DISPLAY_STYLE_T style;
+    const char* text;       // fixed message, or the name of the expected float value
+    _UU32 element;          // UNITY_NO_ELEMENT if not reported
+    _UU32 byte;
+    union
+    {
+        struct { _U_SINT expected; _U_SINT actual; _U_SINT extra; } number;
+        struct { const char* expected; const char* actual; } string;
+        struct { _U_UINT expected; _U_UINT actual; _U_UINT offset; } stream;
+        struct { _U_UINT expected; _U_UINT actual; _U_UINT distance; _U_UINT allowed; } ulps;
+#if defined(UNITY_FLOAT_VERBOSE) || defined(UNITY_DOUBLE_VERBOSE)
+        struct { _UF expected; _UF actual; } real;
+#endif
+    } values;
+    const UnityMismatchSummary* summary;    // NULL unless all mismatches were collected
+    struct
+    {
+        UNITY_PTR_ATTRIBUTE const unsigned char* expected;
+        UNITY_PTR_ATTRIBUTE const unsigned char* actual;
+        size_t length;
+        size_t offset;
+    } memory;               // whole buffers of a memory assert, for the hex dump
+} UnityMismatch;
+
+static void UnitySummaryAdd(UnityMismatchSummary* const summary, const size_t index)
+{
+    const _UU32 last = summary->rangeCount - 1;
+
+    summary->count++;
+    if ((summary->rangeCount > 0) && (summary->last[last] + 1 == index))
+    {
+        summary->last[last] = index;
+    }
+    else if (summary->rangeCount < UNITY_MISMATCH_REPORT_LIMIT)
+    {
+        summary->first[summary->rangeCount] = index;
+        summary->last[summary->rangeCount] = index;
+        summary->rangeCount++;
+    }
+    else
+    {
+        summary->truncated = 1;
+    }
+}
+
+//-----------------------------------------------
+/// Collects the mismatching elements of two arrays of "width" bytes each, starting at the
+/// first known mismatch "index". Runs of equal elements are skipped with the same tight
+/// loop as the assertions use, so this is still a single pass over the data.
+static UNITY_COLD void UnityScanMismatches(UNITY_PTR_ATTRIBUTE const unsigned char* expected,
+                                           UNITY_PTR_ATTRIBUTE const unsigned char* actual,
+                                           const _UU32 width,
+                                           size_t index,
+                                           const size_t num_elements,
+                                           UnityMismatchSummary* const summary)
+{
+    summary->count = 0;
+    summary->rangeCount = 0;
+    summary->truncated = 0;
+
+    while (index < num_elements)
+    {
+        if (memcmp(expected + index * width, actual + index * width, width) != 0)
+        {
+            UnitySummaryAdd(summary, index);
+            index++;
+            continue;
+        }
+        if (width == 1)
+        {
+            for (; (index < num_elements) && (expected[index] == actual[index]); index++) {}
+        }
+        else
+        {
+            index++;
+        }
+    }
+}
+
+//-----------------------------------------------
+#if UNITY_MEMORY_DIFF_CONTEXT > 0
+static void UnityFormatHexRow(char* out,
+                              UNITY_PTR_ATTRIBUTE const unsigned char* data,
+                              UNITY_PTR_ATTRIBUTE const unsigned char* other,
+                              const size_t count)
+{
+    static const char hex[] = "0123456789ABCDEF";
+    size_t i;
+
+    for (i = 0; i < UNITY_MEMORY_DIFF_WIDTH; i++)
+    {
+        if (i < count)
+        {
+            out[3 * i] = (data[i] != other[i]) ? '>' : ' ';
+            out[3 * i + 1] = hex[data[i] >> 4];
+            out[3 * i + 2] = hex[data[i] & 0x0F];
+        }
+        else
+        {
+            out[3 * i] = out[3 * i + 1] = out[3 * i + 2] = ' ';
+        }
+    }
+}
+
+/// Side-by-side hex dump of the rows around "offset", UNITY_MEMORY_DIFF_CONTEXT bytes
+/// each way. Differing bytes are marked with '>'. Each row is formatted into a local
+/// buffer and printed at once, so the output stays bounded however large the buffers are.
+/// Addresses take 8 hex digits, or as many more as the last byte of the buffer needs.
+static UNITY_COLD void UnityPrintMemoryDiff(UNITY_PTR_ATTRIBUTE const unsigned char* expected,
+                                            UNITY_PTR_ATTRIBUTE const unsigned char* actual,
+                                            const size_t length,
+                                            const size_t offset,
+                                            struct _Unity * const unity_p)
+{
+    static const char hex[] = "0123456789ABCDEF";
+    char row[2 + 2 * sizeof(size_t) + 1 + 3 * UNITY_MEMORY_DIFF_WIDTH + 2 + 3 * UNITY_MEMORY_DIFF_WIDTH + 1];
+    size_t start = (offset > UNITY_MEMORY_DIFF_CONTEXT) ? offset - UNITY_MEMORY_DIFF_CONTEXT : 0;
+    size_t end = ((length - offset) > UNITY_MEMORY_DIFF_CONTEXT) ? offset + UNITY_MEMORY_DIFF_CONTEXT + 1 : length;
+    size_t count;
+    int digits;
+    int pos;
+    int i;
+
+    for (digits = 8; (digits < (int)(2 * sizeof(size_t))) && (((length - 1) >> (4 * digits)) != 0); digits++) {}
+    start -= start % UNITY_MEMORY_DIFF_WIDTH;
+    for (; start < end; start += count)
+    {
+        count = ((length - start) < UNITY_MEMORY_DIFF_WIDTH) ? (length - start) : UNITY_MEMORY_DIFF_WIDTH;
+
+        pos = 0;
+        row[pos++] = ' ';
+        row[pos++] = ' ';
+        for (i = digits - 1; i >= 0; i--)
+            row[pos++] = hex[(start >> (i << 2)) & 0x0F];
+        row[pos++] = ' ';
+        UnityFormatHexRow(&row[pos], expected + start, actual + start, count);
+        pos += 3 * UNITY_MEMORY_DIFF_WIDTH;
+        row[pos++] = ' ';
+        row[pos++] = '|';
+        UnityFormatHexRow(&row[pos], actual + start, expected + start, count);
+        pos += 3 * count;
+        row[pos] = '\0';
+        UNITY_PRINT_CHAR('\n', unity_p);
+        UnityPrint(row, unity_p);
+    }
+}
+#endif
+
+//-----------------------------------------------
+static UNITY_COLD void UnityPrintMismatchSummary(const UnityMismatchSummary* const summary,
+                                                 const char* label,
+                                                 struct _Unity * const unity_p)
+{
+    _UU32 i;
+
+    UnityPrint(UnityStrSpacer, unity_p);
+    UnityPrintNumberUnsigned((_U_UINT)summary->count, unity_p);
+    UnityPrint(label, unity_p);
+    for (i = 0; i < summary->rangeCount; i++)
+    {
+        if (i > 0)
+        {
+            UNITY_PRINT_CHAR(',', unity_p);
+            UNITY_PRINT_CHAR(' ', unity_p);
+        }
+        UnityPrintNumberUnsigned((_U_UINT)summary->first[i], unity_p);
+        if (summary->last[i] != summary->first[i])
+        {
+            UNITY_PRINT_CHAR('-', unity_p);
+            UnityPrintNumberUnsigned((_U_UINT)summary->last[i], unity_p);
+        }
+    }
+    if (summary->truncated)
+    {
+        UnityPrint(", ...", unity_p);
+    }
+}
+
+static UNITY_COLD bool UnityReportMismatch(const UnityMismatch* const mismatch,
+                                           const char* msg,
+                                           const UNITY_LINE_TYPE lineNumber, struct _Unity * const unity_p)
+{
+    UnityTestResultsFailBegin(lineNumber, unity_p);
+
+    if (mismatch->kind == UNITY_MISMATCH_MEMORY)
+    {
+        UnityPrint(UnityStrMemory, unity_p);
+    }
+    if (mismatch->element != UNITY_NO_ELEMENT)
+    {
+        UnityPrint(UnityStrElement, unity_p);
+        UnityPrintNumberByStyle(mismatch->element, UNITY_DISPLAY_STYLE_UINT, unity_p);
+    }
+
+    switch (mismatch->kind)
+    {
+        case UNITY_MISMATCH_TEXT:
+            UnityPrint(mismatch->text, unity_p);
+            break;
+        case UNITY_MISMATCH_NUMBER:
+            UnityPrint(UnityStrExpected, unity_p);
+            UnityPrintNumberByStyle(mismatch->values.number.expected, mismatch->style, unity_p);
+            UnityPrint(UnityStrWas, unity_p);
+            UnityPrintNumberByStyle(mismatch->values.number.actual, mismatch->style, unity_p);
+            break;
+        case UNITY_MISMATCH_BITS:
+            UnityPrint(UnityStrExpected, unity_p);
+            UnityPrintMask(mismatch->values.number.extra, mismatch->values.number.expected, unity_p);
+            UnityPrint(UnityStrWas, unity_p);
+            UnityPrintMask(mismatch->values.number.extra, mismatch->values.number.actual, unity_p);
+            break;
+        case UNITY_MISMATCH_DELTA:
+            UnityPrint(UnityStrDelta, unity_p);
+            UnityPrintNumberByStyle(mismatch->values.number.extra, mismatch->style, unity_p);
+            UnityPrint(UnityStrExpected, unity_p);
+            UnityPrintNumberByStyle(mismatch->values.number.expected, mismatch->style, unity_p);
+            UnityPrint(UnityStrWas, unity_p);
+            UnityPrintNumberByStyle(mismatch->values.number.actual, mismatch->style, unity_p);
+            break;
+        case UNITY_MISMATCH_MEMORY:
+            UnityPrint(UnityStrByte, unity_p);
+            UnityPrintNumberByStyle(mismatch->byte, UNITY_DISPLAY_STYLE_UINT, unity_p);
+            UnityPrint(UnityStrExpected, unity_p);
+            UnityPrintNumberByStyle(mismatch->values.number.expected, UNITY_DISPLAY_STYLE_HEX8, unity_p);
+            UnityPrint(UnityStrWas, unity_p);
+            UnityPrintNumberByStyle(mismatch->values.number.actual, UNITY_DISPLAY_STYLE_HEX8, unity_p);
+            break;
+#if defined(UNITY_FLOAT_VERBOSE) || defined(UNITY_DOUBLE_VERBOSE)
+        case UNITY_MISMATCH_FLOAT:
+            UnityPrint(UnityStrExpected, unity_p);
+            if (mismatch->text != NULL)
+            {
+                UnityPrint(mismatch->text, unity_p);
+            }
+            else
+            {
+                UnityPrintFloat(mismatch->values.real.expected, unity_p);
+            }
+            UnityPrint(UnityStrWas, unity_p);
+            UnityPrintFloat(mismatch->values.real.actual, unity_p);
+            break;
+#endif
+        case UNITY_MISMATCH_STRING:
+            UnityPrintExpectedAndActualStrings(mismatch->values.string.expected, mismatch->values.string.actual, unity_p);
+            break;
+        case UNITY_MISMATCH_STREAM:
+            UnityPrint(UnityStrStream, unity_p);
+            UnityPrint(UnityStrByte, unity_p);
+            UnityPrintNumberUnsigned(mismatch->values.stream.offset, unity_p);
+            UnityPrint(UnityStrExpected, unity_p);
+            UnityPrintNumberByStyle((_U_SINT)mismatch->values.stream.expected, UNITY_DISPLAY_STYLE_HEX8, unity_p);
+            UnityPrint(UnityStrWas, unity_p);
+            UnityPrintNumberByStyle((_U_SINT)mismatch->values.stream.actual, UNITY_DISPLAY_STYLE_HEX8, unity_p);
+            break;
+        case UNITY_MISMATCH_ULPS:
+            // a NaN has no distance to anything, the bit patterns are shown instead
+            if (mismatch->text != NULL)
+            {
+                UnityPrint(mismatch->text, unity_p);
+            }
+            else
+            {
+                UnityPrint(" Values ", unity_p);
+                UnityPrintNumberUnsigned(mismatch->values.ulps.distance, unity_p);
+                UnityPrint(UnityStrUlpsApart, unity_p);
+                UnityPrintNumberUnsigned(mismatch->values.ulps.allowed, unity_p);
+                UNITY_PRINT_CHAR('.', unity_p);
+            }
+            UnityPrint(UnityStrExpected, unity_p);
+            UnityPrintNumberByStyle((_U_SINT)mismatch->values.ulps.expected, mismatch->style, unity_p);
+            UnityPrint(UnityStrWas, unity_p);
+            UnityPrintNumberByStyle((_U_SINT)mismatch->values.ulps.actual, mismatch->style, unity_p);
+            break;
+        case UNITY_MISMATCH_DIGEST:
+            UnityPrint(UnityStrDigest, unity_p);
+            UnityPrint(UnityStrExpected, unity_p);
+            UnityPrintNumberByStyle(mismatch->values.number.expected, UNITY_DISPLAY_STYLE_HEX64, unity_p);
+            UnityPrint(UnityStrWas, unity_p);
+            UnityPrintNumberByStyle(mismatch->values.number.actual, UNITY_DISPLAY_STYLE_HEX64, unity_p);
+            break;
+        case UNITY_MISMATCH_STREAM_LENGTH:
+            UnityPrint(UnityStrStreamLength, unity_p);
+            UnityPrint(UnityStrExpected, unity_p);
+            UnityPrintNumberUnsigned(mismatch->values.stream.expected, unity_p);
+            UnityPrint(UnityStrWas, unity_p);
+            UnityPrintNumberUnsigned(mismatch->values.stream.actual, unity_p);
+            break;
+        default:
+            break;
+    }
+
+    if (mismatch->summary != NULL)
+    {
+        UnityPrintMismatchSummary(mismatch->summary,
+                                  (mismatch->kind == UNITY_MISMATCH_MEMORY) ? UnityStrMismatchedBytes : UnityStrMismatchedElements,
+                                  unity_p);
+    }
+    UnityAddMsgIfSpecified(msg, unity_p);
+#if UNITY_MEMORY_DIFF_CONTEXT > 0
+    if (mismatch->kind == UNITY_MISMATCH_MEMORY)
+    {
+        UnityPrintMemoryDiff(mismatch->memory.expected, mismatch->memory.actual,
+                             mismatch->memory.length, mismatch->memory.offset, unity_p);
+    }
+#endif
+    UNITY_FAIL_AND_BAIL;
+}
+
+//-----------------------------------------------
+static UNITY_COLD bool UnityReportText(const char* text,
+                                       const char* msg,
+                                       const UNITY_LINE_TYPE lineNumber, struct _Unity * const unity_p)
+{
+    UnityMismatch mismatch;
+
+    mismatch.kind = UNITY_MISMATCH_TEXT;
+    mismatch.text = text;
+    mismatch.element = UNITY_NO_ELEMENT;
+    mismatch.summary = NULL;
+    return UnityReportMismatch(&mismatch, msg, lineNumber, unity_p);
+}
+
+//-----------------------------------------------
+static UNITY_COLD bool UnityReportNumbers(const UNITY_MISMATCH_KIND_T kind,
+                                          const _UU32 element,
+                                          const _U_SINT expected,
+                                          const _U_SINT actual,
+                                          const _U_SINT extra,
+                                          const UNITY_DISPLAY_STYLE_T style,
+                                          const UnityMismatchSummary* summary,
+                                          const char* msg,
+                                          const UNITY_LINE_TYPE lineNumber, struct _Unity * const unity_p)
+{
+    UnityMismatch mismatch;
+
+    mismatch.kind = kind;
+    mismatch.style = style;
+    mismatch.element = element;
+    mismatch.values.number.expected = expected;
+    mismatch.values.number.actual = actual;
+    mismatch.values.number.extra = extra;
+    mismatch.summary = summary;
+    return UnityReportMismatch(&mismatch, msg, lineNumber, unity_p);
+}
+
+//-----------------------------------------------
+#if !defined(UNITY_EXCLUDE_FLOAT) || !defined(UNITY_EXCLUDE_DOUBLE)
+/// the float asserts report values only if verbose, a plain "not within delta" otherwise
+#if defined(UNITY_FLOAT_VERBOSE) || defined(UNITY_DOUBLE_VERBOSE)
+static UNITY_COLD bool UnityReportFloats(const _UU32 element,
+                                         const char* expectedName,
+                                         const _UF expected,
+                                         const _UF actual,
+                                         const UnityMismatchSummary* summary,
+                                         const char* msg,
+                                         const UNITY_LINE_TYPE lineNumber, struct _Unity * const unity_p)
+{
+    UnityMismatch mismatch;
+
+    mismatch.kind = UNITY_MISMATCH_FLOAT;
+    mismatch.text = expectedName;
+    mismatch.element = element;
+    mismatch.values.real.expected = expected;
+    mismatch.values.real.actual = actual;
+    mismatch.summary = summary;
+    return UnityReportMismatch(&mismatch, msg, lineNumber, unity_p);
+}
+#endif
+
+#if (!defined(UNITY_EXCLUDE_FLOAT) && !defined(UNITY_FLOAT_VERBOSE)) || \
+    (!defined(UNITY_EXCLUDE_DOUBLE) && !defined(UNITY_DOUBLE_VERBOSE))
+static UNITY_COLD bool UnityReportDelta(const _UU32 element,
+                                        const UnityMismatchSummary* summary,
+                                        const char* msg,
+                                        const UNITY_LINE_TYPE lineNumber, struct _Unity * const unity_p)
+{
+    UnityMismatch mismatch;
+
+    mismatch.kind = UNITY_MISMATCH_TEXT;
+    mismatch.text = UnityStrDelta;
+    mismatch.element = element;
+    mismatch.summary = summary;
+    return UnityReportMismatch(&mismatch, msg, lineNumber, unity_p);
+}
+#endif
+
+#ifdef UNITY_FLOAT_VERBOSE
+#define UNITY_REPORT_FLOATS(element, name, expected, actual, summary, msg, line) \
+    UnityReportFloats((element), (name), (_UF)(expected), (_UF)(actual), (summary), (msg), (line), unity_p)
+#else
+#define UNITY_REPORT_FLOATS(element, name, expected, actual, summary, msg, line) \
+    UnityReportDelta((element), (summary), (msg), (line), unity_p)
+#endif
+#ifdef UNITY_DOUBLE_VERBOSE
+#define UNITY_REPORT_DOUBLES(element, name, expected, actual, summary, msg, line) \
+    UnityReportFloats((element), (name), (_UF)(expected), (_UF)(actual), (summary), (msg), (line), unity_p)
+#else
+#define UNITY_REPORT_DOUBLES(element, name, expected, actual, summary, msg, line) \
+    UnityReportDelta((element), (summary), (msg), (line), unity_p)
+#endif
+#endif // float or double support
+
+//-----------------------------------------------
+static UNITY_COLD bool UnityReportStrings(const _UU32 element,
+                                          const char* expected,
+                                          const char* actual,
+                                          const char* msg,
+                                          const UNITY_LINE_TYPE lineNumber, struct _Unity * const unity_p)
+{
+    UnityMismatch mismatch;
+
+    mismatch.kind = UNITY_MISMATCH_STRING;
+    mismatch.element = element;
+    mismatch.values.string.expected = expected;
+    mismatch.values.string.actual = actual;
+    mismatch.summary = NULL;
+    return UnityReportMismatch(&mismatch, msg, lineNumber, unity_p);
+}
+
+//-----------------------------------------------
+static UNITY_COLD bool UnityReportMemory(UNITY_PTR_ATTRIBUTE const unsigned char* expected,
+                                         UNITY_PTR_ATTRIBUTE const unsigned char* actual,
+                                         const _UU32 length,
+                                         const _UU32 num_elements,
+                                         const size_t offset,
+                                         const UnityMismatchSummary* summary,
+                                         const char* msg,
+                                         const UNITY_LINE_TYPE lineNumber, struct _Unity * const unity_p)
+{
+    UnityMismatch mismatch;
+
+    mismatch.kind = UNITY_MISMATCH_MEMORY;
+    mismatch.element = (num_elements > 1) ? (_UU32)(offset / length) : UNITY_NO_ELEMENT;
+    mismatch.byte = (_UU32)(offset % length);
+    mismatch.values.number.expected = expected[offset];
+    mismatch.values.number.actual = actual[offset];
+    mismatch.summary = summary;
+    mismatch.memory.expected = expected;
+    mismatch.memory.actual = actual;
+    mismatch.memory.length = (size_t)length * num_elements;
+    mismatch.memory.offset = offset;
+    return UnityReportMismatch(&mismatch, msg, lineNumber, unity_p);
+}
+
+//-----------------------------------------------
+static UNITY_COLD bool UnityReportStream(const UNITY_MISMATCH_KIND_T kind,
+                                         const _U_UINT offset,
+                                         const _U_UINT expected,
+                                         const _U_UINT actual,
+                                         const char* msg,
+                                         const UNITY_LINE_TYPE lineNumber, struct _Unity * const unity_p)
+{
+    UnityMismatch mismatch;
+
+    mismatch.kind = kind;
+    mismatch.element = UNITY_NO_ELEMENT;
+    mismatch.values.stream.offset = offset;
+    mismatch.values.stream.expected = expected;
+    mismatch.values.stream.actual = actual;
+    mismatch.summary = NULL;
+    return UnityReportMismatch(&mismatch, msg, lineNumber, unity_p);
+}
+
+//-----------------------------------------------
+#if !defined(UNITY_EXCLUDE_FLOAT) || (!defined(UNITY_EXCLUDE_DOUBLE) && defined(UNITY_SUPPORT_64))
+static UNITY_COLD bool UnityReportUlps(const _UU32 element,
+                                       const _U_UINT expected,
+                                       const _U_UINT actual,
+                                       const _U_UINT distance,
+                                       const _U_UINT allowed,
+                                       const int isNaN,
+                                       const UNITY_DISPLAY_STYLE_T style,
+                                       const char* msg,
+                                       const UNITY_LINE_TYPE lineNumber, struct _Unity * const unity_p)
+{
+    UnityMismatch mismatch;
+
+    mismatch.kind = UNITY_MISMATCH_ULPS;
+    mismatch.style = style;
+    mismatch.text = isNaN ? UnityStrUlpsNaN : NULL;
+    mismatch.element = element;
+    mismatch.values.ulps.expected = expected;
+    mismatch.values.ulps.actual = actual;
+    mismatch.values.ulps.distance = distance;
+    mismatch.values.ulps.allowed = allowed;
+    mismatch.summary = NULL;
+    return UnityReportMismatch(&mismatch, msg, lineNumber, unity_p);
+}
+#endif
+
 //-----------------------------------------------
 // Assertion & Control Helpers
 //-----------------------------------------------
@@ -348,21 +916,11 @@ static int UnityCheckArraysForNull(UNITY_PTR_ATTRIBUTE const void* expected, UNI
 
     //throw error if just expected is NULL
     if (expected == NULL)
-    {
-        UnityTestResultsFailBegin(lineNumber, unity_p);
-        UnityPrint(UnityStrNullPointerForExpected, unity_p);
-        UnityAddMsgIfSpecified(msg, unity_p);
-        UNITY_FAIL_AND_BAIL;
-    }
+        return UnityReportText(UnityStrNullPointerForExpected, msg, lineNumber, unity_p);
 
     //throw error if just actual is NULL
     if (actual == NULL)
-    {
-        UnityTestResultsFailBegin(lineNumber, unity_p);
-        UnityPrint(UnityStrNullPointerForActual, unity_p);
-        UnityAddMsgIfSpecified(msg, unity_p);
-        UNITY_FAIL_AND_BAIL;
-    }
+        return UnityReportText(UnityStrNullPointerForActual, msg, lineNumber, unity_p);
 
     //return false if neither is NULL
     return 0;
@@ -372,6 +930,94 @@ static int UnityCheckArraysForNull(UNITY_PTR_ATTRIBUTE const void* expected, UNI
 // Assertion Functions
 //-----------------------------------------------
 
+#if defined(UNITY_PARALLEL)
+//-----------------------------------------------
+/* DX_PATCH: large memory compares are split into one contiguous chunk per helper thread.
+   Every helper walks its chunk in blocks and publishes the first mismatch it finds with an
+   atomic minimum; a helper stops as soon as the published offset lies before its current
+   block, since nothing it could still find would be earlier. The minimum over all chunks is
+   the first mismatch of the whole buffer, so the result is the same as the serial one.
+   Offsets are size_t, as the elements of an array assert can add up to more than 4 GiB. */
+typedef struct _UnityCompareChunk
+{
+    UNITY_PTR_ATTRIBUTE const unsigned char* expected;
+    UNITY_PTR_ATTRIBUTE const unsigned char* actual;
+    size_t begin;
+    size_t end;
+    size_t* first;
+} UnityCompareChunk;
+
+static void UnityPublishMismatch(size_t* const first, const size_t offset)
+{
+    size_t current = __atomic_load_n(first, __ATOMIC_RELAXED);
+
+    while ((offset < current) &&
+           !__atomic_compare_exchange_n(first, &current, offset, 1, __ATOMIC_RELAXED, __ATOMIC_RELAXED))
+    {
+    }
+}
+
+static void* UnityCompareChunkRun(void* arg)
+{
+    const UnityCompareChunk* const chunk = (const UnityCompareChunk*)arg;
+    size_t block, count, i;
+
+    for (block = chunk->begin; block < chunk->end; block += count)
+    {
+        if (__atomic_load_n(chunk->first, __ATOMIC_RELAXED) < block)
+            break;
+
+        count = ((chunk->end - block) < UNITY_PARALLEL_COMPARE_BLOCK) ? (chunk->end - block) : UNITY_PARALLEL_COMPARE_BLOCK;
+        if (memcmp(chunk->expected + block, chunk->actual + block, count) != 0)
+        {
+            for (i = block; chunk->expected[i] == chunk->actual[i]; i++) {}
+            UnityPublishMismatch(chunk->first, i);
+            break;
+        }
+    }
+    return NULL;
+}
+
+/// returns "length" if both buffers are equal
+static size_t UnityParallelFirstMismatch(UNITY_PTR_ATTRIBUTE const unsigned char* expected,
+                                         UNITY_PTR_ATTRIBUTE const unsigned char* actual,
+                                         const size_t length)
+{
+    UnityCompareChunk chunks[UNITY_PARALLEL_COMPARE_THREADS];
+    pthread_t threads[UNITY_PARALLEL_COMPARE_THREADS];
+    int started[UNITY_PARALLEL_COMPARE_THREADS];
+    const size_t share = length / UNITY_PARALLEL_COMPARE_THREADS;
+    const size_t rest = length % UNITY_PARALLEL_COMPARE_THREADS;
+    size_t first = length;
+    int i;
+
+    // chunk i starts at length * i / threads, computed without overflowing length * i
+    for (i = 0; i < UNITY_PARALLEL_COMPARE_THREADS; i++)
+    {
+        chunks[i].expected = expected;
+        chunks[i].actual = actual;
+        chunks[i].begin = share * i + rest * i / UNITY_PARALLEL_COMPARE_THREADS;
+        chunks[i].end = share * (i + 1) + rest * (i + 1) / UNITY_PARALLEL_COMPARE_THREADS;
+        chunks[i].first = &first;
+    }
+
+    // the calling thread takes the first chunk itself, and any chunk whose thread did not start
+    for (i = 1; i < UNITY_PARALLEL_COMPARE_THREADS; i++)
+    {
+        started[i] = (pthread_create(&threads[i], NULL, UnityCompareChunkRun, &chunks[i]) == 0);
+    }
+    UnityCompareChunkRun(&chunks[0]);
+    for (i = 1; i < UNITY_PARALLEL_COMPARE_THREADS; i++)
+    {
+        if (started[i])
+            pthread_join(threads[i], NULL);
+        else
+            UnityCompareChunkRun(&chunks[i]);
+    }
+    return first;
+}
+#endif // UNITY_PARALLEL
+
 /* DX_PATCH: jumpless version. All assertion functions return UNITY_BOOL value instead of void*/
 bool UnityAssertBits(const _U_SINT mask,
                      const _U_SINT expected,
@@ -381,16 +1027,11 @@ bool UnityAssertBits(const _U_SINT mask,
 {
     UNITY_SKIP_EXECUTION;
 
-    if ((mask & expected) != (mask & actual))
+    if (UNITY_UNLIKELY((mask & expected) != (mask & actual)))
     {
         unity_p->TestFile = file;
-        UnityTestResultsFailBegin(lineNumber, unity_p);
-        UnityPrint(UnityStrExpected, unity_p);
-        UnityPrintMask(mask, expected, unity_p);
-        UnityPrint(UnityStrWas, unity_p);
-        UnityPrintMask(mask, actual, unity_p);
-        UnityAddMsgIfSpecified(msg, unity_p);
-        UNITY_FAIL_AND_BAIL;
+        return UnityReportNumbers(UNITY_MISMATCH_BITS, UNITY_NO_ELEMENT, expected, actual, mask,
+                                  UNITY_DISPLAY_STYLE_UNKNOWN, NULL, msg, lineNumber, unity_p);
     }
     return false;
 }
@@ -404,16 +1045,11 @@ bool UnityAssertEqualNumber(const _U_SINT expected,
 {
     UNITY_SKIP_EXECUTION;
 
-    if (expected != actual)
+    if (UNITY_UNLIKELY(expected != actual))
     {
         unity_p->TestFile = file;
-        UnityTestResultsFailBegin(lineNumber, unity_p);
-        UnityPrint(UnityStrExpected, unity_p);
-        UnityPrintNumberByStyle(expected, style, unity_p);
-        UnityPrint(UnityStrWas, unity_p);
-        UnityPrintNumberByStyle(actual, style, unity_p);
-        UnityAddMsgIfSpecified(msg, unity_p);
-        UNITY_FAIL_AND_BAIL;
+        return UnityReportNumbers(UNITY_MISMATCH_NUMBER, UNITY_NO_ELEMENT, expected, actual, 0,
+                                  style, NULL, msg, lineNumber, unity_p);
     }
     return false;
 }
@@ -426,20 +1062,16 @@ bool UnityAssertEqualIntArray(UNITY_PTR_ATTRIBUTE const void* expected,
                               const UNITY_LINE_TYPE lineNumber, const char *file,
                               const UNITY_DISPLAY_STYLE_T style, struct _Unity * const unity_p)
 {
-    _UU32 elements = num_elements;
-    UNITY_PTR_ATTRIBUTE const _US8* ptr_exp = (UNITY_PTR_ATTRIBUTE _US8*)expected;
-    UNITY_PTR_ATTRIBUTE const _US8* ptr_act = (UNITY_PTR_ATTRIBUTE _US8*)actual;
+    _UU32 i;
+    _UU32 width;
+    _U_SINT expect_val;
+    _U_SINT actual_val;
 
     UNITY_SKIP_EXECUTION;
 
     unity_p->TestFile = file;
-    if (elements == 0)
-    {
-        UnityTestResultsFailBegin(lineNumber, unity_p);
-        UnityPrint(UnityStrPointless, unity_p);
-        UnityAddMsgIfSpecified(msg, unity_p);
-        UNITY_FAIL_AND_BAIL;
-    }
+    if (num_elements == 0)
+        return UnityReportText(UnityStrPointless, msg, lineNumber, unity_p);
 
     if (UnityCheckArraysForNull((UNITY_PTR_ATTRIBUTE void*)expected, (UNITY_PTR_ATTRIBUTE void*)actual, lineNumber, msg, unity_p) == 1)
         return true;
@@ -452,149 +1084,138 @@ bool UnityAssertEqualIntArray(UNITY_PTR_ATTRIBUTE const void* expected,
         case UNITY_DISPLAY_STYLE_HEX8:
         case UNITY_DISPLAY_STYLE_INT8:
         case UNITY_DISPLAY_STYLE_UINT8:
-            while (elements--)
-            {
-                if (*ptr_exp != *ptr_act)
-                {
-                    UnityTestResultsFailBegin(lineNumber, unity_p);
-                    UnityPrint(UnityStrElement, unity_p);
-                    UnityPrintNumberByStyle((num_elements - elements - 1), UNITY_DISPLAY_STYLE_UINT, unity_p);
-                    UnityPrint(UnityStrExpected, unity_p);
-                    UnityPrintNumberByStyle(*ptr_exp, style, unity_p);
-                    UnityPrint(UnityStrWas, unity_p);
-                    UnityPrintNumberByStyle(*ptr_act, style, unity_p);
-                    UnityAddMsgIfSpecified(msg, unity_p);
-                    UNITY_FAIL_AND_BAIL;
-                }
-                ptr_exp += 1;
-                ptr_act += 1;
-            }
+        {
+            UNITY_PTR_ATTRIBUTE const _US8* ptr_exp = (UNITY_PTR_ATTRIBUTE const _US8*)expected;
+            UNITY_PTR_ATTRIBUTE const _US8* ptr_act = (UNITY_PTR_ATTRIBUTE const _US8*)actual;
+            for (i = 0; (i < num_elements) && (ptr_exp[i] == ptr_act[i]); i++) {}
+            if (UNITY_LIKELY(i == num_elements))
+                return false;
+            width = 1;
+            expect_val = ptr_exp[i];
+            actual_val = ptr_act[i];
             break;
+        }
         case UNITY_DISPLAY_STYLE_HEX16:
         case UNITY_DISPLAY_STYLE_INT16:
         case UNITY_DISPLAY_STYLE_UINT16:
-            while (elements--)
-            {
-                if (*(UNITY_PTR_ATTRIBUTE _US16*)ptr_exp != *(UNITY_PTR_ATTRIBUTE _US16*)ptr_act)
-                {
-                    UnityTestResultsFailBegin(lineNumber, unity_p);
-                    UnityPrint(UnityStrElement, unity_p);
-                    UnityPrintNumberByStyle((num_elements - elements - 1), UNITY_DISPLAY_STYLE_UINT, unity_p);
-                    UnityPrint(UnityStrExpected, unity_p);
-                    UnityPrintNumberByStyle(*(UNITY_PTR_ATTRIBUTE _US16*)ptr_exp, style, unity_p);
-                    UnityPrint(UnityStrWas, unity_p);
-                    UnityPrintNumberByStyle(*(UNITY_PTR_ATTRIBUTE _US16*)ptr_act, style, unity_p);
-                    UnityAddMsgIfSpecified(msg, unity_p);
-                    UNITY_FAIL_AND_BAIL;
-                }
-                ptr_exp += 2;
-                ptr_act += 2;
-            }
+        {
+            UNITY_PTR_ATTRIBUTE const _US16* ptr_exp = (UNITY_PTR_ATTRIBUTE const _US16*)expected;
+            UNITY_PTR_ATTRIBUTE const _US16* ptr_act = (UNITY_PTR_ATTRIBUTE const _US16*)actual;
+            for (i = 0; (i < num_elements) && (ptr_exp[i] == ptr_act[i]); i++) {}
+            if (UNITY_LIKELY(i == num_elements))
+                return false;
+            width = 2;
+            expect_val = ptr_exp[i];
+            actual_val = ptr_act[i];
             break;
+        }
 #ifdef UNITY_SUPPORT_64
         case UNITY_DISPLAY_STYLE_HEX64:
         case UNITY_DISPLAY_STYLE_INT64:
         case UNITY_DISPLAY_STYLE_UINT64:
-            while (elements--)
-            {
-                if (*(UNITY_PTR_ATTRIBUTE _US64*)ptr_exp != *(UNITY_PTR_ATTRIBUTE _US64*)ptr_act)
-                {
-                    UnityTestResultsFailBegin(lineNumber, unity_p);
-                    UnityPrint(UnityStrElement, unity_p);
-                    UnityPrintNumberByStyle((num_elements - elements - 1), UNITY_DISPLAY_STYLE_UINT, unity_p);
-                    UnityPrint(UnityStrExpected, unity_p);
-                    UnityPrintNumberByStyle(*(UNITY_PTR_ATTRIBUTE _US64*)ptr_exp, style, unity_p);
-                    UnityPrint(UnityStrWas, unity_p);
-                    UnityPrintNumberByStyle(*(UNITY_PTR_ATTRIBUTE _US64*)ptr_act, style, unity_p);
-                    UnityAddMsgIfSpecified(msg, unity_p);
-                    UNITY_FAIL_AND_BAIL;
-                }
-                ptr_exp += 8;
-                ptr_act += 8;
-            }
+        {
+            UNITY_PTR_ATTRIBUTE const _US64* ptr_exp = (UNITY_PTR_ATTRIBUTE const _US64*)expected;
+            UNITY_PTR_ATTRIBUTE const _US64* ptr_act = (UNITY_PTR_ATTRIBUTE const _US64*)actual;
+            for (i = 0; (i < num_elements) && (ptr_exp[i] == ptr_act[i]); i++) {}
+            if (UNITY_LIKELY(i == num_elements))
+                return false;
+            width = 8;
+            expect_val = ptr_exp[i];
+            actual_val = ptr_act[i];
             break;
+        }
 #endif
         default:
-            while (elements--)
-            {
-                if (*(UNITY_PTR_ATTRIBUTE _US32*)ptr_exp != *(UNITY_PTR_ATTRIBUTE _US32*)ptr_act)
-                {
-                    UnityTestResultsFailBegin(lineNumber, unity_p);
-                    UnityPrint(UnityStrElement, unity_p);
-                    UnityPrintNumberByStyle((num_elements - elements - 1), UNITY_DISPLAY_STYLE_UINT, unity_p);
-                    UnityPrint(UnityStrExpected, unity_p);
-                    UnityPrintNumberByStyle(*(UNITY_PTR_ATTRIBUTE _US32*)ptr_exp, style, unity_p);
-                    UnityPrint(UnityStrWas, unity_p);
-                    UnityPrintNumberByStyle(*(UNITY_PTR_ATTRIBUTE _US32*)ptr_act, style, unity_p);
-                    UnityAddMsgIfSpecified(msg, unity_p);
-                    UNITY_FAIL_AND_BAIL;
-                }
-                ptr_exp += 4;
-                ptr_act += 4;
-            }
+        {
+            UNITY_PTR_ATTRIBUTE const _US32* ptr_exp = (UNITY_PTR_ATTRIBUTE const _US32*)expected;
+            UNITY_PTR_ATTRIBUTE const _US32* ptr_act = (UNITY_PTR_ATTRIBUTE const _US32*)actual;
+            for (i = 0; (i < num_elements) && (ptr_exp[i] == ptr_act[i]); i++) {}
+            if (UNITY_LIKELY(i == num_elements))
+                return false;
+            width = 4;
+            expect_val = ptr_exp[i];
+            actual_val = ptr_act[i];
             break;
+        }
     }
-    return false;
+
+    if (unity_p->ReportAllMismatches)
+    {
+        UnityMismatchSummary summary;
+        UnityScanMismatches((UNITY_PTR_ATTRIBUTE const unsigned char*)expected,
+                            (UNITY_PTR_ATTRIBUTE const unsigned char*)actual,
+                            width, i, num_elements, &summary);
+        return UnityReportNumbers(UNITY_MISMATCH_NUMBER, i, expect_val, actual_val, 0,
+                                  style, &summary, msg, lineNumber, unity_p);
+    }
+    return UnityReportNumbers(UNITY_MISMATCH_NUMBER, i, expect_val, actual_val, 0,
+                              style, NULL, msg, lineNumber, unity_p);
 }
 
 //-----------------------------------------------
 #ifndef UNITY_EXCLUDE_FLOAT
-bool UnityAssertEqualFloatArray(UNITY_PTR_ATTRIBUTE const _UF* expected,
-                                UNITY_PTR_ATTRIBUTE const _UF* actual,
-                                const _UU32 num_elements,
-                                const char* msg,
-                                const UNITY_LINE_TYPE lineNumber, const char *file, struct _Unity * const unity_p)
+/// relative comparison used by the float array assert
+static int UnityFloatsDiffer(const _UF expected, const _UF actual)
 {
-    _UU32 elements = num_elements;
-    UNITY_PTR_ATTRIBUTE const _UF* ptr_expected = expected;
-    UNITY_PTR_ATTRIBUTE const _UF* ptr_actual = actual;
-    _UF diff, tol;
+    _UF diff = expected - actual;
+    _UF tol = UNITY_FLOAT_PRECISION * expected;
 
-    UNITY_SKIP_EXECUTION;
+    if (diff < 0.0f)
+        diff = 0.0f - diff;
+    if (tol < 0.0f)
+        tol = 0.0f - tol;
 
-    unity_p->TestFile = file;
+    //This first part of this condition will catch any NaN or Infinite values
+    return (diff * 0.0f != 0.0f) || (diff > tol);
+}
+
+static UNITY_COLD void UnityScanFloatMismatches(UNITY_PTR_ATTRIBUTE const _UF* expected,
+                                           UNITY_PTR_ATTRIBUTE const _UF* actual,
+                                           _UU32 index,
+                                           const _UU32 num_elements,
+                                           UnityMismatchSummary* const summary)
+{
+    summary->count = 0;
+    summary->rangeCount = 0;
+    summary->truncated = 0;
 
-    if (elements == 0)
+    for (; index < num_elements; index++)
     {
-        UnityTestResultsFailBegin(lineNumber, unity_p);
-        UnityPrint(UnityStrPointless, unity_p);
-        UnityAddMsgIfSpecified(msg, unity_p);
-        UNITY_FAIL_AND_BAIL;
+        if (UnityFloatsDiffer(expected[index], actual[index]))
+            UnitySummaryAdd(summary, index);
     }
+}
+
+//-----------------------------------------------
+bool UnityAssertEqualFloatArray(UNITY_PTR_ATTRIBUTE const _UF* expected,
+                                UNITY_PTR_ATTRIBUTE const _UF* actual,
+                                const _UU32 num_elements,
+                                const char* msg,
+                                const UNITY_LINE_TYPE lineNumber, const char *file, struct _Unity * const unity_p)
+{
+    _UU32 i;
+
+    UNITY_SKIP_EXECUTION;
+
+    unity_p->TestFile = file;
+
+    if (num_elements == 0)
+        return UnityReportText(UnityStrPointless, msg, lineNumber, unity_p);
 
     if (UnityCheckArraysForNull((UNITY_PTR_ATTRIBUTE void*)expected, (UNITY_PTR_ATTRIBUTE void*)actual, lineNumber, msg, unity_p) == 1)
         return true;
 
-    while (elements--)
-    {
-        diff = *ptr_expected - *ptr_actual;
-        if (diff < 0.0f)
-          diff = 0.0f - diff;
-        tol = UNITY_FLOAT_PRECISION * *ptr_expected;
-        if (tol < 0.0f)
-            tol = 0.0f - tol;
+    for (i = 0; (i < num_elements) && !UnityFloatsDiffer(expected[i], actual[i]); i++) {}
+    if (UNITY_LIKELY(i == num_elements))
+        return false;
 
-        //This first part of this condition will catch any NaN or Infinite values
-        if ((diff * 0.0f != 0.0f) || (diff > tol))
-        {
-            UnityTestResultsFailBegin(lineNumber, unity_p);
-            UnityPrint(UnityStrElement, unity_p);
-            UnityPrintNumberByStyle((num_elements - elements - 1), UNITY_DISPLAY_STYLE_UINT, unity_p);
-#ifdef UNITY_FLOAT_VERBOSE
-            UnityPrint(UnityStrExpected, unity_p);
-            UnityPrintFloat(*ptr_expected, unity_p);
-            UnityPrint(UnityStrWas, unity_p);
-            UnityPrintFloat(*ptr_actual, unity_p);
-#else
-            UnityPrint(UnityStrDelta, unity_p);
-#endif
-            UnityAddMsgIfSpecified(msg, unity_p);
-            UNITY_FAIL_AND_BAIL;
-        }
-        ptr_expected++;
-        ptr_actual++;
+    if (unity_p->ReportAllMismatches)
+    {
+        UnityMismatchSummary summary;
+        UnityScanFloatMismatches(expected, actual, i, num_elements, &summary);
+        return UNITY_REPORT_FLOATS(i, NULL, expected[i], actual[i], &summary, msg, lineNumber);
     }
-    return false;
+    return UNITY_REPORT_FLOATS(i, NULL, expected[i], actual[i], NULL, msg, lineNumber);
 }
 
 //-----------------------------------------------
@@ -619,20 +1240,10 @@ bool UnityAssertFloatsWithin(const _UF delta,
     }
 
     //This first part of this condition will catch any NaN or Infinite values
-    if ((diff * 0.0f != 0.0f) || (pos_delta < diff))
+    if (UNITY_UNLIKELY((diff * 0.0f != 0.0f) || (pos_delta < diff)))
     {
         unity_p->TestFile = file;
-        UnityTestResultsFailBegin(lineNumber, unity_p);
-#ifdef UNITY_FLOAT_VERBOSE
-        UnityPrint(UnityStrExpected, unity_p);
-        UnityPrintFloat(expected, unity_p);
-        UnityPrint(UnityStrWas, unity_p);
-        UnityPrintFloat(actual, unity_p);
-#else
-        UnityPrint(UnityStrDelta, unity_p);
-#endif
-        UnityAddMsgIfSpecified(msg, unity_p);
-        UNITY_FAIL_AND_BAIL;
+        return UNITY_REPORT_FLOATS(UNITY_NO_ELEMENT, NULL, expected, actual, NULL, msg, lineNumber);
     }
     return false;
 }
@@ -649,21 +1260,10 @@ bool UnityAssertFloatIsInf(const _UF actual,
     // produces
     //   error C2124: divide or mod by zero
     // As a workaround, place 0 into a variable.
-    if (INFINITY != actual)
+    if (UNITY_UNLIKELY(INFINITY != actual))
     {
         unity_p->TestFile = file;
-
-        UnityTestResultsFailBegin(lineNumber, unity_p);
-#ifdef UNITY_FLOAT_VERBOSE
-        UnityPrint(UnityStrExpected, unity_p);
-        UnityPrint(UnityStrInf, unity_p);
-        UnityPrint(UnityStrWas, unity_p);
-        UnityPrintFloat(actual, unity_p);
-#else
-        UnityPrint(UnityStrDelta, unity_p);
-#endif
-        UnityAddMsgIfSpecified(msg, unity_p);
-        UNITY_FAIL_AND_BAIL;
+        return UNITY_REPORT_FLOATS(UNITY_NO_ELEMENT, UnityStrInf, 0.0f, actual, NULL, msg, lineNumber);
     }
     return false;
 }
@@ -676,21 +1276,10 @@ bool UnityAssertFloatIsNegInf(const _UF actual,
     UNITY_SKIP_EXECUTION;
 
     // The rationale for not using 1.0f/0.0f is given in UnityAssertFloatIsInf's body.
-    if (-INFINITY != actual)
+    if (UNITY_UNLIKELY(-INFINITY != actual))
     {
         unity_p->TestFile = file;
-
-        UnityTestResultsFailBegin(lineNumber, unity_p);
-#ifdef UNITY_FLOAT_VERBOSE
-        UnityPrint(UnityStrExpected, unity_p);
-        UnityPrint(UnityStrNegInf, unity_p);
-        UnityPrint(UnityStrWas, unity_p);
-        UnityPrintFloat(actual, unity_p);
-#else
-        UnityPrint(UnityStrDelta, unity_p);
-#endif
-        UnityAddMsgIfSpecified(msg, unity_p);
-        UNITY_FAIL_AND_BAIL;
+        return UNITY_REPORT_FLOATS(UNITY_NO_ELEMENT, UnityStrNegInf, 0.0f, actual, NULL, msg, lineNumber);
     }
     return false;
 }
@@ -702,85 +1291,176 @@ bool UnityAssertFloatIsNaN(const _UF actual,
 {
     UNITY_SKIP_EXECUTION;
 
-    if (actual == actual)
+    if (UNITY_UNLIKELY(actual == actual))
     {
         unity_p->TestFile = file;
+        return UNITY_REPORT_FLOATS(UNITY_NO_ELEMENT, UnityStrNaN, 0.0f, actual, NULL, msg, lineNumber);
+    }
+    return false;
+}
 
-        UnityTestResultsFailBegin(lineNumber, unity_p);
-#ifdef UNITY_FLOAT_VERBOSE
-        UnityPrint(UnityStrExpected, unity_p);
-        UnityPrint(UnityStrNaN, unity_p);
-        UnityPrint(UnityStrWas, unity_p);
-        UnityPrintFloat(actual, unity_p);
-#else
-        UnityPrint(UnityStrDelta, unity_p);
+//-----------------------------------------------
+/* DX_PATCH: ULP comparison. The bit patterns are mapped onto one unsigned scale that is
+   ordered like the values themselves, with -0 and +0 on the same point, so the distance
+   in ULPs is a plain subtraction. Arrays are checked in blocks of UNITY_ULPS_BLOCK elements
+   without an early exit, which lets the compiler run each block in SIMD lanes; only a
+   failing block is searched again for the exact element. A NaN on either side always
+   fails. UNITY_FLOAT_TYPE has to be a 32 bit IEEE 754 type for this. */
+#ifndef UNITY_ULPS_BLOCK
+#define UNITY_ULPS_BLOCK        64
 #endif
-        UnityAddMsgIfSpecified(msg, unity_p);
-        UNITY_FAIL_AND_BAIL;
+#define UNITY_FLOAT_SIGN        0x80000000u
+#define UNITY_FLOAT_EXP_MASK    0x7F800000u
+
+static _UU32 UnityFloatKey(const _UU32 bits)
+{
+    return (bits & UNITY_FLOAT_SIGN) ? UNITY_FLOAT_SIGN - (bits & ~UNITY_FLOAT_SIGN) : UNITY_FLOAT_SIGN + bits;
+}
+
+static int UnityFloatUlpsFail(const _UF expected, const _UF actual, const _UU32 ulps)
+{
+    _UU32 exp_bits, act_bits, exp_key, act_key;
+
+    memcpy(&exp_bits, &expected, sizeof(exp_bits));
+    memcpy(&act_bits, &actual, sizeof(act_bits));
+    exp_key = UnityFloatKey(exp_bits);
+    act_key = UnityFloatKey(act_bits);
+    return ((exp_bits & ~UNITY_FLOAT_SIGN) > UNITY_FLOAT_EXP_MASK) |
+           ((act_bits & ~UNITY_FLOAT_SIGN) > UNITY_FLOAT_EXP_MASK) |
+           (((exp_key > act_key) ? exp_key - act_key : act_key - exp_key) > ulps);
+}
+
+static bool UnityCompareFloatUlps(const _UU32 ulps,
+                                  UNITY_PTR_ATTRIBUTE const _UF* expected,
+                                  UNITY_PTR_ATTRIBUTE const _UF* actual,
+                                  const _UU32 num_elements,
+                                  const int is_array,
+                                  const char* msg,
+                                  const UNITY_LINE_TYPE lineNumber, struct _Unity * const unity_p)
+{
+    _UU32 i, block, count;
+    _UU32 exp_bits, act_bits, exp_key, act_key;
+    int failed = 0;
+
+    // whole blocks are checked without an early exit, so the loop can be vectorized
+    for (block = 0; (block < num_elements) && !failed; block += count)
+    {
+        count = ((num_elements - block) < UNITY_ULPS_BLOCK) ? (num_elements - block) : UNITY_ULPS_BLOCK;
+        for (i = 0; i < count; i++)
+            failed |= UnityFloatUlpsFail(expected[block + i], actual[block + i], ulps);
     }
-    return false;
+    if (UNITY_LIKELY(!failed))
+        return false;
+
+    for (i = block - count; !UnityFloatUlpsFail(expected[i], actual[i], ulps); i++) {}
+    memcpy(&exp_bits, &expected[i], sizeof(exp_bits));
+    memcpy(&act_bits, &actual[i], sizeof(act_bits));
+    exp_key = UnityFloatKey(exp_bits);
+    act_key = UnityFloatKey(act_bits);
+    return UnityReportUlps(is_array ? i : UNITY_NO_ELEMENT, exp_bits, act_bits,
+                           (exp_key > act_key) ? exp_key - act_key : act_key - exp_key, ulps,
+                           ((exp_bits & ~UNITY_FLOAT_SIGN) > UNITY_FLOAT_EXP_MASK) || ((act_bits & ~UNITY_FLOAT_SIGN) > UNITY_FLOAT_EXP_MASK),
+                           UNITY_DISPLAY_STYLE_HEX32, msg, lineNumber, unity_p);
+}
+
+bool UnityAssertFloatUlps(const _UU32 ulps,
+                          const _UF expected,
+                          const _UF actual,
+                          const char* msg,
+                          const UNITY_LINE_TYPE lineNumber, const char *file, struct _Unity * const unity_p)
+{
+    UNITY_SKIP_EXECUTION;
+
+    unity_p->TestFile = file;
+    return UnityCompareFloatUlps(ulps, &expected, &actual, 1, 0, msg, lineNumber, unity_p);
+}
+
+bool UnityAssertFloatArrayUlps(const _UU32 ulps,
+                               UNITY_PTR_ATTRIBUTE const _UF* expected,
+                               UNITY_PTR_ATTRIBUTE const _UF* actual,
+                               const _UU32 num_elements,
+                               const char* msg,
+                               const UNITY_LINE_TYPE lineNumber, const char *file, struct _Unity * const unity_p)
+{
+    UNITY_SKIP_EXECUTION;
+
+    unity_p->TestFile = file;
+
+    if (num_elements == 0)
+        return UnityReportText(UnityStrPointless, msg, lineNumber, unity_p);
+
+    if (UnityCheckArraysForNull((UNITY_PTR_ATTRIBUTE void*)expected, (UNITY_PTR_ATTRIBUTE void*)actual, lineNumber, msg, unity_p) == 1)
+        return true;
+
+    return UnityCompareFloatUlps(ulps, expected, actual, num_elements, 1, msg, lineNumber, unity_p);
 }
 
 #endif //not UNITY_EXCLUDE_FLOAT
 
 //-----------------------------------------------
 #ifndef UNITY_EXCLUDE_DOUBLE
+/// relative comparison used by the double array assert
+static int UnityDoublesDiffer(const _UD expected, const _UD actual)
+{
+    _UD diff = expected - actual;
+    _UD tol = UNITY_DOUBLE_PRECISION * expected;
+
+    if (diff < 0.0)
+        diff = 0.0 - diff;
+    if (tol < 0.0)
+        tol = 0.0 - tol;
+
+    //This first part of this condition will catch any NaN or Infinite values
+    return (diff * 0.0 != 0.0) || (diff > tol);
+}
+
+static UNITY_COLD void UnityScanDoubleMismatches(UNITY_PTR_ATTRIBUTE const _UD* expected,
+                                            UNITY_PTR_ATTRIBUTE const _UD* actual,
+                                            _UU32 index,
+                                            const _UU32 num_elements,
+                                            UnityMismatchSummary* const summary)
+{
+    summary->count = 0;
+    summary->rangeCount = 0;
+    summary->truncated = 0;
+
+    for (; index < num_elements; index++)
+    {
+        if (UnityDoublesDiffer(expected[index], actual[index]))
+            UnitySummaryAdd(summary, index);
+    }
+}
+
+//-----------------------------------------------
 bool UnityAssertEqualDoubleArray(UNITY_PTR_ATTRIBUTE const _UD* expected,
                                  UNITY_PTR_ATTRIBUTE const _UD* actual,
                                  const _UU32 num_elements,
                                  const char* msg,
                                  const UNITY_LINE_TYPE lineNumber, const char *file, struct _Unity * const unity_p)
 {
-    _UU32 elements = num_elements;
-    UNITY_PTR_ATTRIBUTE const _UD* ptr_expected = expected;
-    UNITY_PTR_ATTRIBUTE const _UD* ptr_actual = actual;
-    _UD diff, tol;
+    _UU32 i;
 
     UNITY_SKIP_EXECUTION;
 
     unity_p->TestFile = file;
 
-    if (elements == 0)
-    {
-        UnityTestResultsFailBegin(lineNumber, unity_p);
-        UnityPrint(UnityStrPointless, unity_p);
-        UnityAddMsgIfSpecified(msg, unity_p);
-        UNITY_FAIL_AND_BAIL;
-    }
+    if (num_elements == 0)
+        return UnityReportText(UnityStrPointless, msg, lineNumber, unity_p);
 
     if (UnityCheckArraysForNull((UNITY_PTR_ATTRIBUTE void*)expected, (UNITY_PTR_ATTRIBUTE void*)actual, lineNumber, msg, unity_p) == 1)
         return true;
 
-    while (elements--)
-    {
-        diff = *ptr_expected - *ptr_actual;
-        if (diff < 0.0)
-          diff = 0.0 - diff;
-        tol = UNITY_DOUBLE_PRECISION * *ptr_expected;
-        if (tol < 0.0)
-            tol = 0.0 - tol;
+    for (i = 0; (i < num_elements) && !UnityDoublesDiffer(expected[i], actual[i]); i++) {}
+    if (UNITY_LIKELY(i == num_elements))
+        return false;
 
-        //This first part of this condition will catch any NaN or Infinite values
-        if ((diff * 0.0 != 0.0) || (diff > tol))
-        {
-            UnityTestResultsFailBegin(lineNumber, unity_p);
-            UnityPrint(UnityStrElement, unity_p);
-            UnityPrintNumberByStyle((num_elements - elements - 1), UNITY_DISPLAY_STYLE_UINT, unity_p);
-#ifdef UNITY_DOUBLE_VERBOSE
-            UnityPrint(UnityStrExpected, unity_p);
-            UnityPrintFloat((float)(*ptr_expected), unity_p);
-            UnityPrint(UnityStrWas, unity_p);
-            UnityPrintFloat((float)(*ptr_actual), unity_p);
-#else
-            UnityPrint(UnityStrDelta, unity_p);
-#endif
-            UnityAddMsgIfSpecified(msg, unity_p);
-            UNITY_FAIL_AND_BAIL;
-        }
-        ptr_expected++;
-        ptr_actual++;
+    if (unity_p->ReportAllMismatches)
+    {
+        UnityMismatchSummary summary;
+        UnityScanDoubleMismatches(expected, actual, i, num_elements, &summary);
+        return UNITY_REPORT_DOUBLES(i, NULL, expected[i], actual[i], &summary, msg, lineNumber);
     }
-    return false;
+    return UNITY_REPORT_DOUBLES(i, NULL, expected[i], actual[i], NULL, msg, lineNumber);
 }
 
 //-----------------------------------------------
@@ -805,21 +1485,10 @@ bool UnityAssertDoublesWithin(const _UD delta,
     }
 
     //This first part of this condition will catch any NaN or Infinite values
-    if ((diff * 0.0 != 0.0) || (pos_delta < diff))
+    if (UNITY_UNLIKELY((diff * 0.0 != 0.0) || (pos_delta < diff)))
     {
         unity_p->TestFile = file;
-
-        UnityTestResultsFailBegin(lineNumber, unity_p);
-#ifdef UNITY_DOUBLE_VERBOSE
-        UnityPrint(UnityStrExpected, unity_p);
-        UnityPrintFloat((float)expected, unity_p);
-        UnityPrint(UnityStrWas, unity_p);
-        UnityPrintFloat((float)actual, unity_p);
-#else
-        UnityPrint(UnityStrDelta, unity_p);
-#endif
-        UnityAddMsgIfSpecified(msg, unity_p);
-        UNITY_FAIL_AND_BAIL;
+        return UNITY_REPORT_DOUBLES(UNITY_NO_ELEMENT, NULL, expected, actual, NULL, msg, lineNumber);
     }
     return false;
 }
@@ -832,20 +1501,8 @@ bool UnityAssertDoubleIsInf(const _UD actual,
     UNITY_SKIP_EXECUTION;
 
     // The rationale for not using 1.0/0.0 is given in UnityAssertFloatIsInf's body.
-    if ((1.0 / d_zero) != actual)
-    {
-        UnityTestResultsFailBegin(lineNumber, unity_p);
-#ifdef UNITY_DOUBLE_VERBOSE
-        UnityPrint(UnityStrExpected, unity_p);
-        UnityPrint(UnityStrInf, unity_p);
-        UnityPrint(UnityStrWas, unity_p);
-        UnityPrintFloat((float)actual, unity_p);
-#else
-        UnityPrint(UnityStrDelta, unity_p);
-#endif
-        UnityAddMsgIfSpecified(msg, unity_p);
-        UNITY_FAIL_AND_BAIL;
-    }
+    if (UNITY_UNLIKELY((1.0 / d_zero) != actual))
+        return UNITY_REPORT_DOUBLES(UNITY_NO_ELEMENT, UnityStrInf, 0.0, actual, NULL, msg, lineNumber);
     return false;
 }
 
@@ -857,20 +1514,8 @@ bool UnityAssertDoubleIsNegInf(const _UD actual,
     UNITY_SKIP_EXECUTION;
 
     // The rationale for not using 1.0/0.0 is given in UnityAssertFloatIsInf's body.
-    if ((-1.0 / d_zero) != actual)
-    {
-        UnityTestResultsFailBegin(lineNumber, unity_p);
-#ifdef UNITY_DOUBLE_VERBOSE
-        UnityPrint(UnityStrExpected, unity_p);
-        UnityPrint(UnityStrNegInf, unity_p);
-        UnityPrint(UnityStrWas, unity_p);
-        UnityPrintFloat((float)actual, unity_p);
-#else
-        UnityPrint(UnityStrDelta, unity_p);
-#endif
-        UnityAddMsgIfSpecified(msg, unity_p);
-        UNITY_FAIL_AND_BAIL;
-    }
+    if (UNITY_UNLIKELY((-1.0 / d_zero) != actual))
+        return UNITY_REPORT_DOUBLES(UNITY_NO_ELEMENT, UnityStrNegInf, 0.0, actual, NULL, msg, lineNumber);
     return false;
 }
 
@@ -881,23 +1526,101 @@ bool UnityAssertDoubleIsNaN(const _UD actual,
 {
     UNITY_SKIP_EXECUTION;
 
-    if (actual == actual)
+    if (UNITY_UNLIKELY(actual == actual))
+        return UNITY_REPORT_DOUBLES(UNITY_NO_ELEMENT, UnityStrNaN, 0.0, actual, NULL, msg, lineNumber);
+    return false;
+}
+
+//-----------------------------------------------
+/// same as the float ULP comparison above, UNITY_DOUBLE_TYPE has to be a 64 bit IEEE 754 type
+#ifdef UNITY_SUPPORT_64
+#define UNITY_DOUBLE_SIGN       0x8000000000000000ull
+#define UNITY_DOUBLE_EXP_MASK   0x7FF0000000000000ull
+
+static _UU64 UnityDoubleKey(const _UU64 bits)
+{
+    return (bits & UNITY_DOUBLE_SIGN) ? UNITY_DOUBLE_SIGN - (bits & ~UNITY_DOUBLE_SIGN) : UNITY_DOUBLE_SIGN + bits;
+}
+
+static int UnityDoubleUlpsFail(const _UD expected, const _UD actual, const _UU64 ulps)
+{
+    _UU64 exp_bits, act_bits, exp_key, act_key;
+
+    memcpy(&exp_bits, &expected, sizeof(exp_bits));
+    memcpy(&act_bits, &actual, sizeof(act_bits));
+    exp_key = UnityDoubleKey(exp_bits);
+    act_key = UnityDoubleKey(act_bits);
+    return ((exp_bits & ~UNITY_DOUBLE_SIGN) > UNITY_DOUBLE_EXP_MASK) |
+           ((act_bits & ~UNITY_DOUBLE_SIGN) > UNITY_DOUBLE_EXP_MASK) |
+           (((exp_key > act_key) ? exp_key - act_key : act_key - exp_key) > ulps);
+}
+
+static bool UnityCompareDoubleUlps(const _UU64 ulps,
+                                   UNITY_PTR_ATTRIBUTE const _UD* expected,
+                                   UNITY_PTR_ATTRIBUTE const _UD* actual,
+                                   const _UU32 num_elements,
+                                   const int is_array,
+                                   const char* msg,
+                                   const UNITY_LINE_TYPE lineNumber, struct _Unity * const unity_p)
+{
+    _UU32 i, block, count;
+    _UU64 exp_bits, act_bits, exp_key, act_key;
+    int failed = 0;
+
+    // whole blocks are checked without an early exit, so the loop can be vectorized
+    for (block = 0; (block < num_elements) && !failed; block += count)
     {
-        UnityTestResultsFailBegin(lineNumber, unity_p);
-#ifdef UNITY_DOUBLE_VERBOSE
-        UnityPrint(UnityStrExpected, unity_p);
-        UnityPrint(UnityStrNaN, unity_p);
-        UnityPrint(UnityStrWas, unity_p);
-        UnityPrintFloat((float)actual, unity_p);
-#else
-        UnityPrint(UnityStrDelta, unity_p);
-#endif
-        UnityAddMsgIfSpecified(msg, unity_p);
-        UNITY_FAIL_AND_BAIL;
+        count = ((num_elements - block) < UNITY_ULPS_BLOCK) ? (num_elements - block) : UNITY_ULPS_BLOCK;
+        for (i = 0; i < count; i++)
+            failed |= UnityDoubleUlpsFail(expected[block + i], actual[block + i], ulps);
     }
-    return false;
+    if (UNITY_LIKELY(!failed))
+        return false;
+
+    for (i = block - count; !UnityDoubleUlpsFail(expected[i], actual[i], ulps); i++) {}
+    memcpy(&exp_bits, &expected[i], sizeof(exp_bits));
+    memcpy(&act_bits, &actual[i], sizeof(act_bits));
+    exp_key = UnityDoubleKey(exp_bits);
+    act_key = UnityDoubleKey(act_bits);
+    return UnityReportUlps(is_array ? i : UNITY_NO_ELEMENT, exp_bits, act_bits,
+                           (exp_key > act_key) ? exp_key - act_key : act_key - exp_key, ulps,
+                           ((exp_bits & ~UNITY_DOUBLE_SIGN) > UNITY_DOUBLE_EXP_MASK) || ((act_bits & ~UNITY_DOUBLE_SIGN) > UNITY_DOUBLE_EXP_MASK),
+                           UNITY_DISPLAY_STYLE_HEX64, msg, lineNumber, unity_p);
+}
+
+bool UnityAssertDoubleUlps(const _UU64 ulps,
+                           const _UD expected,
+                           const _UD actual,
+                           const char* msg,
+                           const UNITY_LINE_TYPE lineNumber, const char *file, struct _Unity * const unity_p)
+{
+    UNITY_SKIP_EXECUTION;
+
+    unity_p->TestFile = file;
+    return UnityCompareDoubleUlps(ulps, &expected, &actual, 1, 0, msg, lineNumber, unity_p);
 }
 
+bool UnityAssertDoubleArrayUlps(const _UU64 ulps,
+                                UNITY_PTR_ATTRIBUTE const _UD* expected,
+                                UNITY_PTR_ATTRIBUTE const _UD* actual,
+                                const _UU32 num_elements,
+                                const char* msg,
+                                const UNITY_LINE_TYPE lineNumber, const char *file, struct _Unity * const unity_p)
+{
+    UNITY_SKIP_EXECUTION;
+
+    unity_p->TestFile = file;
+
+    if (num_elements == 0)
+        return UnityReportText(UnityStrPointless, msg, lineNumber, unity_p);
+
+    if (UnityCheckArraysForNull((UNITY_PTR_ATTRIBUTE void*)expected, (UNITY_PTR_ATTRIBUTE void*)actual, lineNumber, msg, unity_p) == 1)
+        return true;
+
+    return UnityCompareDoubleUlps(ulps, expected, actual, num_elements, 1, msg, lineNumber, unity_p);
+}
+#endif // UNITY_SUPPORT_64
+
 #endif // not UNITY_EXCLUDE_DOUBLE
 
 //-----------------------------------------------
@@ -927,17 +1650,10 @@ bool UnityAssertNumbersWithin( const _U_SINT delta,
             unity_p->CurrentTestFailed = ((_U_UINT)(expected - actual) > (_U_UINT)delta);
     }
 
-    if (unity_p->CurrentTestFailed)
+    if (UNITY_UNLIKELY(unity_p->CurrentTestFailed))
     {
-        UnityTestResultsFailBegin(lineNumber, unity_p);
-        UnityPrint(UnityStrDelta, unity_p);
-        UnityPrintNumberByStyle(delta, style, unity_p);
-        UnityPrint(UnityStrExpected, unity_p);
-        UnityPrintNumberByStyle(expected, style, unity_p);
-        UnityPrint(UnityStrWas, unity_p);
-        UnityPrintNumberByStyle(actual, style, unity_p);
-        UnityAddMsgIfSpecified(msg, unity_p);
-        UNITY_FAIL_AND_BAIL;
+        return UnityReportNumbers(UNITY_MISMATCH_DELTA, UNITY_NO_ELEMENT, expected, actual, delta,
+                                  style, NULL, msg, lineNumber, unity_p);
     }
     return false;
 }
@@ -974,13 +1690,8 @@ bool UnityAssertEqualString(const char* expected,
         }
     }
 
-    if (unity_p->CurrentTestFailed)
-    {
-      UnityTestResultsFailBegin(lineNumber, unity_p);
-      UnityPrintExpectedAndActualStrings(expected, actual, unity_p);
-      UnityAddMsgIfSpecified(msg, unity_p);
-      UNITY_FAIL_AND_BAIL;
-    }
+    if (UNITY_UNLIKELY(unity_p->CurrentTestFailed))
+        return UnityReportStrings(UNITY_NO_ELEMENT, expected, actual, msg, lineNumber, unity_p);
     return false;
 }
 
@@ -997,12 +1708,7 @@ bool UnityAssertEqualStringArray( const char** expected,
 
     // if no elements, it's an error
     if (num_elements == 0)
-    {
-        UnityTestResultsFailBegin(lineNumber, unity_p);
-        UnityPrint(UnityStrPointless, unity_p);
-        UnityAddMsgIfSpecified(msg, unity_p);
-        UNITY_FAIL_AND_BAIL;
-    }
+        return UnityReportText(UnityStrPointless, msg, lineNumber, unity_p);
 
     if (UnityCheckArraysForNull((UNITY_PTR_ATTRIBUTE void*)expected, (UNITY_PTR_ATTRIBUTE void*)actual, lineNumber, msg, unity_p) == 1)
         return true;
@@ -1029,17 +1735,11 @@ bool UnityAssertEqualStringArray( const char** expected,
             }
         }
 
-        if (unity_p->CurrentTestFailed)
+        if (UNITY_UNLIKELY(unity_p->CurrentTestFailed))
         {
-            UnityTestResultsFailBegin(lineNumber, unity_p);
-            if (num_elements > 1)
-            {
-                UnityPrint(UnityStrElement, unity_p);
-                UnityPrintNumberByStyle((j), UNITY_DISPLAY_STYLE_UINT, unity_p);
-            }
-            UnityPrintExpectedAndActualStrings((const char*)(expected[j]), (const char*)(actual[j]), unity_p);
-            UnityAddMsgIfSpecified(msg, unity_p);
-            UNITY_FAIL_AND_BAIL;
+            return UnityReportStrings((num_elements > 1) ? j : UNITY_NO_ELEMENT,
+                                      (const char*)(expected[j]), (const char*)(actual[j]),
+                                      msg, lineNumber, unity_p);
         }
     } while (++j < num_elements);
 
@@ -1054,55 +1754,275 @@ bool UnityAssertEqualMemory( UNITY_PTR_ATTRIBUTE const void* expected,
                              const char* msg,
                              const UNITY_LINE_TYPE lineNumber, const char *file, struct _Unity * const unity_p)
 {
-    UNITY_PTR_ATTRIBUTE unsigned char* ptr_exp = (UNITY_PTR_ATTRIBUTE unsigned char*)expected;
-    UNITY_PTR_ATTRIBUTE unsigned char* ptr_act = (UNITY_PTR_ATTRIBUTE unsigned char*)actual;
-    _UU32 elements = num_elements;
-    _UU32 bytes;
+    UNITY_PTR_ATTRIBUTE const unsigned char* ptr_exp = (UNITY_PTR_ATTRIBUTE const unsigned char*)expected;
+    UNITY_PTR_ATTRIBUTE const unsigned char* ptr_act = (UNITY_PTR_ATTRIBUTE const unsigned char*)actual;
+    const size_t total = (size_t)length * num_elements;
+    _UU32 element;
+    _UU32 byte;
+    size_t offset;
 
     UNITY_SKIP_EXECUTION;
 
     unity_p->TestFile = file;
 
-    if ((elements == 0) || (length == 0))
-    {
-        UnityTestResultsFailBegin(lineNumber, unity_p);
-        UnityPrint(UnityStrPointless, unity_p);
-        UnityAddMsgIfSpecified(msg, unity_p);
-        UNITY_FAIL_AND_BAIL;
-    }
+    if ((num_elements == 0) || (length == 0))
+        return UnityReportText(UnityStrPointless, msg, lineNumber, unity_p);
 
     if (UnityCheckArraysForNull((UNITY_PTR_ATTRIBUTE void*)expected, (UNITY_PTR_ATTRIBUTE void*)actual, lineNumber, msg, unity_p) == 1)
         return true;
 
-    while (elements--)
+#if defined(UNITY_PARALLEL)
+    if (total >= UNITY_PARALLEL_COMPARE_THRESHOLD)
     {
-        /////////////////////////////////////
-        bytes = length;
-        while (bytes--)
+        offset = UnityParallelFirstMismatch(ptr_exp, ptr_act, total);
+        if (UNITY_LIKELY(offset == total))
+            return false;
+    }
+    else
+#endif
+    {
+        for (element = 0; element < num_elements; element++)
         {
-            if (*ptr_exp != *ptr_act)
-            {
-                UnityTestResultsFailBegin(lineNumber, unity_p);
-                UnityPrint(UnityStrMemory, unity_p);
-                if (num_elements > 1)
-                {
-                    UnityPrint(UnityStrElement, unity_p);
-                    UnityPrintNumberByStyle((num_elements - elements - 1), UNITY_DISPLAY_STYLE_UINT, unity_p);
-                }
-                UnityPrint(UnityStrByte, unity_p);
-                UnityPrintNumberByStyle((length - bytes - 1), UNITY_DISPLAY_STYLE_UINT, unity_p);
-                UnityPrint(UnityStrExpected, unity_p);
-                UnityPrintNumberByStyle(*ptr_exp, UNITY_DISPLAY_STYLE_HEX8, unity_p);
-                UnityPrint(UnityStrWas, unity_p);
-                UnityPrintNumberByStyle(*ptr_act, UNITY_DISPLAY_STYLE_HEX8, unity_p);
-                UnityAddMsgIfSpecified(msg, unity_p);
-                UNITY_FAIL_AND_BAIL;
-            }
-            ptr_exp += 1;
-            ptr_act += 1;
+            for (byte = 0; (byte < length) && (ptr_exp[byte] == ptr_act[byte]); byte++) {}
+            if (UNITY_UNLIKELY(byte < length))
+                break;
+            ptr_exp += length;
+            ptr_act += length;
         }
-        /////////////////////////////////////
+        if (UNITY_LIKELY(element == num_elements))
+            return false;
+        offset = (size_t)element * length + byte;
+    }
 
+    if (unity_p->ReportAllMismatches)
+    {
+        UnityMismatchSummary summary;
+        UnityScanMismatches((UNITY_PTR_ATTRIBUTE const unsigned char*)expected,
+                            (UNITY_PTR_ATTRIBUTE const unsigned char*)actual,
+                            1, offset, total, &summary);
+        return UnityReportMemory((UNITY_PTR_ATTRIBUTE const unsigned char*)expected,
+                                 (UNITY_PTR_ATTRIBUTE const unsigned char*)actual,
+                                 length, num_elements, offset,
+                                 &summary, msg, lineNumber, unity_p);
+    }
+    return UnityReportMemory((UNITY_PTR_ATTRIBUTE const unsigned char*)expected,
+                             (UNITY_PTR_ATTRIBUTE const unsigned char*)actual,
+                             length, num_elements, offset,
+                             NULL, msg, lineNumber, unity_p);
+}
+
+//-----------------------------------------------
+// Digests
+//-----------------------------------------------
+
+/* DX_PATCH: XXH64, so that large reference data can be checked against a 64 bit digest
+   compiled into the test instead of the data itself. The input is read as little endian
+   words, so a digest is the same on every host and matches other XXH64 implementations. */
+#ifdef UNITY_SUPPORT_64
+#define UNITY_XXH_PRIME64_1 0x9E3779B185EBCA87ull
+#define UNITY_XXH_PRIME64_2 0xC2B2AE3D27D4EB4Full
+#define UNITY_XXH_PRIME64_3 0x165667B19E3779F9ull
+#define UNITY_XXH_PRIME64_4 0x85EBCA77C2B2AE63ull
+#define UNITY_XXH_PRIME64_5 0x27D4EB2F165667C5ull
+#define UNITY_XXH_ROTL64(x, r) (((x) << (r)) | ((x) >> (64 - (r))))
+
+static _UU64 UnityXXHRead64(UNITY_PTR_ATTRIBUTE const unsigned char* p)
+{
+    _UU64 value;
+    memcpy(&value, p, sizeof(value));
+#if defined(__BYTE_ORDER__) && (__BYTE_ORDER__ == __ORDER_BIG_ENDIAN__)
+    value = __builtin_bswap64(value);
+#endif
+    return value;
+}
+
+static _UU32 UnityXXHRead32(UNITY_PTR_ATTRIBUTE const unsigned char* p)
+{
+    _UU32 value;
+    memcpy(&value, p, sizeof(value));
+#if defined(__BYTE_ORDER__) && (__BYTE_ORDER__ == __ORDER_BIG_ENDIAN__)
+    value = __builtin_bswap32(value);
+#endif
+    return value;
+}
+
+static _UU64 UnityXXHRound(_UU64 acc, const _UU64 input)
+{
+    acc += input * UNITY_XXH_PRIME64_2;
+    acc = UNITY_XXH_ROTL64(acc, 31);
+    return acc * UNITY_XXH_PRIME64_1;
+}
+
+static _UU64 UnityXXHMerge(_UU64 acc, const _UU64 value)
+{
+    acc ^= UnityXXHRound(0, value);
+    return acc * UNITY_XXH_PRIME64_1 + UNITY_XXH_PRIME64_4;
+}
+
+_UU64 UnityDigest(UNITY_PTR_ATTRIBUTE const void* data, const _UU32 length)
+{
+    UNITY_PTR_ATTRIBUTE const unsigned char* p = (UNITY_PTR_ATTRIBUTE const unsigned char*)data;
+    UNITY_PTR_ATTRIBUTE const unsigned char* const end = p + length;
+    _UU64 hash;
+
+    if (length >= 32)
+    {
+        // four independent lanes keep the multipliers busy
+        _UU64 v1 = UNITY_XXH_PRIME64_1 + UNITY_XXH_PRIME64_2;
+        _UU64 v2 = UNITY_XXH_PRIME64_2;
+        _UU64 v3 = 0;
+        _UU64 v4 = 0 - UNITY_XXH_PRIME64_1;
+
+        do
+        {
+            v1 = UnityXXHRound(v1, UnityXXHRead64(p));
+            v2 = UnityXXHRound(v2, UnityXXHRead64(p + 8));
+            v3 = UnityXXHRound(v3, UnityXXHRead64(p + 16));
+            v4 = UnityXXHRound(v4, UnityXXHRead64(p + 24));
+            p += 32;
+        } while (p + 32 <= end);
+
+        hash = UNITY_XXH_ROTL64(v1, 1) + UNITY_XXH_ROTL64(v2, 7) + UNITY_XXH_ROTL64(v3, 12) + UNITY_XXH_ROTL64(v4, 18);
+        hash = UnityXXHMerge(hash, v1);
+        hash = UnityXXHMerge(hash, v2);
+        hash = UnityXXHMerge(hash, v3);
+        hash = UnityXXHMerge(hash, v4);
+    }
+    else
+    {
+        hash = UNITY_XXH_PRIME64_5;
+    }
+    hash += length;
+
+    for (; p + 8 <= end; p += 8)
+    {
+        hash ^= UnityXXHRound(0, UnityXXHRead64(p));
+        hash = UNITY_XXH_ROTL64(hash, 27) * UNITY_XXH_PRIME64_1 + UNITY_XXH_PRIME64_4;
+    }
+    if (p + 4 <= end)
+    {
+        hash ^= (_UU64)UnityXXHRead32(p) * UNITY_XXH_PRIME64_1;
+        hash = UNITY_XXH_ROTL64(hash, 23) * UNITY_XXH_PRIME64_2 + UNITY_XXH_PRIME64_3;
+        p += 4;
+    }
+    for (; p < end; p++)
+    {
+        hash ^= (*p) * UNITY_XXH_PRIME64_5;
+        hash = UNITY_XXH_ROTL64(hash, 11) * UNITY_XXH_PRIME64_1;
+    }
+
+    hash ^= hash >> 33;
+    hash *= UNITY_XXH_PRIME64_2;
+    hash ^= hash >> 29;
+    hash *= UNITY_XXH_PRIME64_3;
+    hash ^= hash >> 32;
+    return hash;
+}
+
+//-----------------------------------------------
+/// With RecordDigests set the digest is printed as "file:line:test:DIGEST: 0x..." and the
+/// assertion passes, so the expected values of a new test can be collected in one run.
+bool UnityAssertDigestEqual(const _UU64 expected,
+                            UNITY_PTR_ATTRIBUTE const void* actual,
+                            const _UU32 length,
+                            const char* msg,
+                            const UNITY_LINE_TYPE lineNumber, const char *file, struct _Unity * const unity_p)
+{
+    _UU64 digest;
+
+    UNITY_SKIP_EXECUTION;
+
+    unity_p->TestFile = file;
+
+    if ((actual == NULL) && (length > 0))
+        return UnityReportText(UnityStrNullPointerForActual, msg, lineNumber, unity_p);
+
+    digest = UnityDigest(actual, length);
+    if (unity_p->RecordDigests)
+    {
+        UnityTestResultsBegin(file, lineNumber, unity_p);
+        UnityPrint("DIGEST: ", unity_p);
+        UnityPrintNumberByStyle((_U_SINT)digest, UNITY_DISPLAY_STYLE_HEX64, unity_p);
+        UNITY_PRINT_CHAR('\n', unity_p);
+        return false;
+    }
+    if (UNITY_UNLIKELY(digest != expected))
+    {
+        return UnityReportNumbers(UNITY_MISMATCH_DIGEST, UNITY_NO_ELEMENT, (_U_SINT)expected, (_U_SINT)digest, 0,
+                                  UNITY_DISPLAY_STYLE_HEX64, NULL, msg, lineNumber, unity_p);
+    }
+    return false;
+}
+#endif // UNITY_SUPPORT_64
+
+//-----------------------------------------------
+// Streaming Compare
+//-----------------------------------------------
+
+/* DX_PATCH: compares two byte streams that are produced piecewise and never held in
+   memory as a whole. Like zlib's avail_in, each feed consumes as much as both chunks
+   have in common and advances the caller's pointers and lengths, so the caller refills
+   whichever side ran dry and feeds again. Only the global offset is kept. */
+void UnityStreamCompareBegin(UnityStreamCompare* const stream)
+{
+    stream->Offset = 0;
+}
+
+//-----------------------------------------------
+bool UnityStreamCompareFeed(UnityStreamCompare* const stream,
+                            UNITY_PTR_ATTRIBUTE const unsigned char** expected,
+                            _UU32* const expected_len,
+                            UNITY_PTR_ATTRIBUTE const unsigned char** actual,
+                            _UU32* const actual_len,
+                            const char* msg,
+                            const UNITY_LINE_TYPE lineNumber, const char *file, struct _Unity * const unity_p)
+{
+    UNITY_PTR_ATTRIBUTE const unsigned char* ptr_exp = *expected;
+    UNITY_PTR_ATTRIBUTE const unsigned char* ptr_act = *actual;
+    const _UU32 count = (*expected_len < *actual_len) ? *expected_len : *actual_len;
+    _UU32 i;
+
+    UNITY_SKIP_EXECUTION;
+
+    if (count > 0)
+    {
+        unity_p->TestFile = file;
+        if (ptr_exp == NULL)
+            return UnityReportText(UnityStrNullPointerForExpected, msg, lineNumber, unity_p);
+        if (ptr_act == NULL)
+            return UnityReportText(UnityStrNullPointerForActual, msg, lineNumber, unity_p);
+    }
+
+    for (i = 0; (i < count) && (ptr_exp[i] == ptr_act[i]); i++) {}
+    if (UNITY_UNLIKELY(i < count))
+    {
+        return UnityReportStream(UNITY_MISMATCH_STREAM, stream->Offset + i, ptr_exp[i], ptr_act[i],
+                                 msg, lineNumber, unity_p);
+    }
+
+    stream->Offset += count;
+    *expected = ptr_exp + count;
+    *expected_len -= count;
+    *actual = ptr_act + count;
+    *actual_len -= count;
+    return false;
+}
+
+//-----------------------------------------------
+bool UnityStreamCompareEnd(UnityStreamCompare* const stream,
+                           const _UU32 expected_left,
+                           const _UU32 actual_left,
+                           const char* msg,
+                           const UNITY_LINE_TYPE lineNumber, const char *file, struct _Unity * const unity_p)
+{
+    UNITY_SKIP_EXECUTION;
+
+    if (UNITY_UNLIKELY(expected_left != actual_left))
+    {
+        unity_p->TestFile = file;
+        return UnityReportStream(UNITY_MISMATCH_STREAM_LENGTH, stream->Offset,
+                                 stream->Offset + expected_left, stream->Offset + actual_left,
+                                 msg, lineNumber, unity_p);
     }
     return false;
 }
@@ -1124,10 +2044,10 @@ bool UnityFail(const char* message, const UNITY_LINE_TYPE line, const char *file
     UnityPrintFail(unity_p);
     if (message != NULL)
     {
-      UNITY_OUTPUT_CHAR(':');
+      UNITY_PRINT_CHAR(':', unity_p);
       if (message[0] != ' ')
       {
-        UNITY_OUTPUT_CHAR(' ');
+        UNITY_PRINT_CHAR(' ', unity_p);
       }
       UnityPrint(message, unity_p);
     }
@@ -1143,8 +2063,8 @@ bool UnityIgnore(const char* message, const UNITY_LINE_TYPE line, const char *fi
     UnityPrint("IGNORE", unity_p);
     if (message != NULL)
     {
-      UNITY_OUTPUT_CHAR(':');
-      UNITY_OUTPUT_CHAR(' ');
+      UNITY_PRINT_CHAR(':', unity_p);
+      UNITY_PRINT_CHAR(' ', unity_p);
       UnityPrint(message, unity_p);
     }
     UNITY_IGNORE_AND_BAIL;
@@ -1183,11 +2103,32 @@ void UnityBegin( struct _Unity * const unity_p )
     unity_p->CurrentTestFailed = 0;
     unity_p->CurrentTestIgnored = 0;
     unity_p->testLocalStorage = NULL;
+    unity_p->OutputMuted = 0;
+    unity_p->MallocFailIndex = -1;
+    unity_p->RestoreStack = NULL;
+    unity_p->RestoreLength = 0;
+    unity_p->RestoreCapacity = 0;
+    unity_p->Capture = NULL;
+    unity_p->ResultSlots = NULL;
+    unity_p->ResultSlotCount = 0;
+    unity_p->Parallel = NULL;
 }
 
 //-----------------------------------------------
 int UnityEnd( struct _Unity * const unity_p )
 {
+    unsigned int i;
+
+    /* DX_PATCH: fold in the per-worker results of a parallel run */
+    for (i = 0; i < unity_p->ResultSlotCount; i++)
+    {
+        unity_p->NumberOfTests += unity_p->ResultSlots[i].NumberOfTests;
+        unity_p->TestFailures += unity_p->ResultSlots[i].TestFailures;
+        unity_p->TestIgnores += unity_p->ResultSlots[i].TestIgnores;
+    }
+    unity_p->ResultSlots = NULL;
+    unity_p->ResultSlotCount = 0;
+
     UnityPrint("-----------------------", unity_p);
     UNITY_PRINT_EOL;
     UnityPrintNumber(unity_p->NumberOfTests, unity_p);
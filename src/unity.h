@@ -126,6 +126,13 @@
 #define TEST_ASSERT_EQUAL_STRING(expected, actual)                                                 UNITY_TEST_ASSERT_EQUAL_STRING(expected, actual, __LINE__, NULL)
 #define TEST_ASSERT_EQUAL_MEMORY(expected, actual, len)                                            UNITY_TEST_ASSERT_EQUAL_MEMORY(expected, actual, len, __LINE__, NULL)
 
+//Digests (64 bit XXH64 of the actual data, needs UNITY_SUPPORT_64)
+#define TEST_ASSERT_DIGEST_EQUAL(expected_digest, actual, len)                                     UNITY_TEST_ASSERT_DIGEST_EQUAL(expected_digest, actual, len, __LINE__, NULL)
+
+//Streams: "expected" and "actual" are const unsigned char* variables and the lengths _UU32 variables, all advanced by each feed
+#define TEST_ASSERT_STREAM_FEED(stream, expected, expected_len, actual, actual_len)                UNITY_TEST_ASSERT_STREAM_FEED(stream, expected, expected_len, actual, actual_len, __LINE__, NULL)
+#define TEST_ASSERT_STREAM_END(stream, expected_left, actual_left)                                 UNITY_TEST_ASSERT_STREAM_END(stream, expected_left, actual_left, __LINE__, NULL)
+
 //Arrays
 #define TEST_ASSERT_EQUAL_INT_ARRAY(expected, actual, num_elements)                                UNITY_TEST_ASSERT_EQUAL_INT_ARRAY(expected, actual, num_elements, __LINE__, NULL)
 #define TEST_ASSERT_EQUAL_INT8_ARRAY(expected, actual, num_elements)                               UNITY_TEST_ASSERT_EQUAL_INT8_ARRAY(expected, actual, num_elements, __LINE__, NULL)
@@ -153,6 +160,8 @@
 #define TEST_ASSERT_FLOAT_IS_INF(actual)                                                           UNITY_TEST_ASSERT_FLOAT_IS_INF(actual, __LINE__, NULL)
 #define TEST_ASSERT_FLOAT_IS_NEG_INF(actual)                                                       UNITY_TEST_ASSERT_FLOAT_IS_NEG_INF(actual, __LINE__, NULL)
 #define TEST_ASSERT_FLOAT_IS_NAN(actual)                                                           UNITY_TEST_ASSERT_FLOAT_IS_NAN(actual, __LINE__, NULL)
+#define TEST_ASSERT_FLOAT_ULPS(ulps, expected, actual)                                             UNITY_TEST_ASSERT_FLOAT_ULPS(ulps, expected, actual, __LINE__, NULL)
+#define TEST_ASSERT_FLOAT_ARRAY_ULPS(ulps, expected, actual, num_elements)                         UNITY_TEST_ASSERT_FLOAT_ARRAY_ULPS(ulps, expected, actual, num_elements, __LINE__, NULL)
 
 //Double (If Enabled)
 #define TEST_ASSERT_DOUBLE_WITHIN(delta, expected, actual)                                         UNITY_TEST_ASSERT_DOUBLE_WITHIN(delta, expected, actual, __LINE__, NULL)
@@ -161,6 +170,8 @@
 #define TEST_ASSERT_DOUBLE_IS_INF(actual)                                                          UNITY_TEST_ASSERT_DOUBLE_IS_INF(actual, __LINE__, NULL)
 #define TEST_ASSERT_DOUBLE_IS_NEG_INF(actual)                                                      UNITY_TEST_ASSERT_DOUBLE_IS_NEG_INF(actual, __LINE__, NULL)
 #define TEST_ASSERT_DOUBLE_IS_NAN(actual)                                                          UNITY_TEST_ASSERT_DOUBLE_IS_NAN(actual, __LINE__, NULL)
+#define TEST_ASSERT_DOUBLE_ULPS(ulps, expected, actual)                                            UNITY_TEST_ASSERT_DOUBLE_ULPS(ulps, expected, actual, __LINE__, NULL)
+#define TEST_ASSERT_DOUBLE_ARRAY_ULPS(ulps, expected, actual, num_elements)                        UNITY_TEST_ASSERT_DOUBLE_ARRAY_ULPS(ulps, expected, actual, num_elements, __LINE__, NULL)
 
 //-------------------------------------------------------
 // Test Asserts (with additional messages)
@@ -212,6 +223,13 @@
 #define TEST_ASSERT_EQUAL_STRING_MESSAGE(expected, actual, message)                                UNITY_TEST_ASSERT_EQUAL_STRING(expected, actual, __LINE__, message)
 #define TEST_ASSERT_EQUAL_MEMORY_MESSAGE(expected, actual, len, message)                           UNITY_TEST_ASSERT_EQUAL_MEMORY(expected, actual, len, __LINE__, message)
 
+//Digests
+#define TEST_ASSERT_DIGEST_EQUAL_MESSAGE(expected_digest, actual, len, message)                    UNITY_TEST_ASSERT_DIGEST_EQUAL(expected_digest, actual, len, __LINE__, message)
+
+//Streams
+#define TEST_ASSERT_STREAM_FEED_MESSAGE(stream, expected, expected_len, actual, actual_len, message) UNITY_TEST_ASSERT_STREAM_FEED(stream, expected, expected_len, actual, actual_len, __LINE__, message)
+#define TEST_ASSERT_STREAM_END_MESSAGE(stream, expected_left, actual_left, message)                UNITY_TEST_ASSERT_STREAM_END(stream, expected_left, actual_left, __LINE__, message)
+
 //Arrays
 #define TEST_ASSERT_EQUAL_INT_ARRAY_MESSAGE(expected, actual, num_elements, message)               UNITY_TEST_ASSERT_EQUAL_INT_ARRAY(expected, actual, num_elements, __LINE__, message)
 #define TEST_ASSERT_EQUAL_INT8_ARRAY_MESSAGE(expected, actual, num_elements, message)              UNITY_TEST_ASSERT_EQUAL_INT8_ARRAY(expected, actual, num_elements, __LINE__, message)
@@ -239,6 +257,8 @@
 #define TEST_ASSERT_FLOAT_IS_INF_MESSAGE(actual, message)                                          UNITY_TEST_ASSERT_FLOAT_IS_INF(actual, __LINE__, message)
 #define TEST_ASSERT_FLOAT_IS_NEG_INF_MESSAGE(actual, message)                                      UNITY_TEST_ASSERT_FLOAT_IS_NEG_INF(actual, __LINE__, message)
 #define TEST_ASSERT_FLOAT_IS_NAN_MESSAGE(actual, message)                                          UNITY_TEST_ASSERT_FLOAT_IS_NAN(actual, __LINE__, message)
+#define TEST_ASSERT_FLOAT_ULPS_MESSAGE(ulps, expected, actual, message)                            UNITY_TEST_ASSERT_FLOAT_ULPS(ulps, expected, actual, __LINE__, message)
+#define TEST_ASSERT_FLOAT_ARRAY_ULPS_MESSAGE(ulps, expected, actual, num_elements, message)        UNITY_TEST_ASSERT_FLOAT_ARRAY_ULPS(ulps, expected, actual, num_elements, __LINE__, message)
 
 //Double (If Enabled)
 #define TEST_ASSERT_DOUBLE_WITHIN_MESSAGE(delta, expected, actual, message)                        UNITY_TEST_ASSERT_DOUBLE_WITHIN(delta, expected, actual, __LINE__, message)
@@ -247,4 +267,6 @@
 #define TEST_ASSERT_DOUBLE_IS_INF_MESSAGE(actual, message)                                         UNITY_TEST_ASSERT_DOUBLE_IS_INF(actual, __LINE__, message)
 #define TEST_ASSERT_DOUBLE_IS_NEG_INF_MESSAGE(actual, message)                                     UNITY_TEST_ASSERT_DOUBLE_IS_NEG_INF(actual, __LINE__, message)
 #define TEST_ASSERT_DOUBLE_IS_NAN_MESSAGE(actual, message)                                         UNITY_TEST_ASSERT_DOUBLE_IS_NAN(actual, __LINE__, message)
+#define TEST_ASSERT_DOUBLE_ULPS_MESSAGE(ulps, expected, actual, message)                           UNITY_TEST_ASSERT_DOUBLE_ULPS(ulps, expected, actual, __LINE__, message)
+#define TEST_ASSERT_DOUBLE_ARRAY_ULPS_MESSAGE(ulps, expected, actual, num_elements, message)       UNITY_TEST_ASSERT_DOUBLE_ARRAY_ULPS(ulps, expected, actual, num_elements, __LINE__, message)
 #endif
@@ -249,6 +249,10 @@ typedef UNITY_DOUBLE_TYPE _UD;
 extern int UNITY_OUTPUT_CHAR(int);
 #endif
 
+/* DX_PATCH: framework output is routed through the test context, so that a runner
+   can silence it. UNITY_OUTPUT_CHAR stays the final sink. */
+#define UNITY_PRINT_CHAR(a, context) UnityPrintChar((a), (context))
+
 //-------------------------------------------------------
 // Footprint
 //-------------------------------------------------------
@@ -261,6 +265,137 @@ extern int UNITY_OUTPUT_CHAR(int);
 #define UNITY_COUNTER_TYPE int
 #endif
 
+/* DX_PATCH: failure reporting is kept out of line and out of the hot text, so that
+   the comparison loops of the assertions stay small */
+#if defined(__GNUC__)
+#define UNITY_COLD          __attribute__((cold, noinline))
+#define UNITY_LIKELY(x)     __builtin_expect(!!(x), 1)
+#define UNITY_UNLIKELY(x)   __builtin_expect(!!(x), 0)
+#else
+#define UNITY_COLD
+#define UNITY_LIKELY(x)     (x)
+#define UNITY_UNLIKELY(x)   (x)
+#endif
+
+// Number of mismatch ranges listed by an array assert in ReportAllMismatches mode
+#ifndef UNITY_MISMATCH_REPORT_LIMIT
+#define UNITY_MISMATCH_REPORT_LIMIT 8
+#endif
+
+// Bytes shown on each side of the first difference of a failed memory assert, 0 disables the dump
+#ifndef UNITY_MEMORY_DIFF_CONTEXT
+#define UNITY_MEMORY_DIFF_CONTEXT 16
+#endif
+#ifndef UNITY_MEMORY_DIFF_WIDTH
+#define UNITY_MEMORY_DIFF_WIDTH 16
+#endif
+
+// Memory asserts of at least this many bytes are split across helper threads (UNITY_PARALLEL only)
+#ifndef UNITY_PARALLEL_COMPARE_THRESHOLD
+#define UNITY_PARALLEL_COMPARE_THRESHOLD (64ul * 1024ul * 1024ul)
+#endif
+#ifndef UNITY_PARALLEL_COMPARE_THREADS
+#define UNITY_PARALLEL_COMPARE_THREADS 4
+#endif
+#ifndef UNITY_PARALLEL_COMPARE_BLOCK
+#define UNITY_PARALLEL_COMPARE_BLOCK (256u * 1024u)
+#endif
+
+// Used to keep per-worker data of a parallel run on separate cache lines
+#ifndef UNITY_CACHE_LINE_SIZE
+#define UNITY_CACHE_LINE_SIZE 64
+#endif
+
+// Size classes of the debug allocator (UNITY_DYNAMIC_MEM_DEBUG), and the blocks kept per class
+#ifndef UNITY_MALLOC_CLASS_MIN
+#define UNITY_MALLOC_CLASS_MIN 32u
+#endif
+#ifndef UNITY_MALLOC_CLASSES
+#define UNITY_MALLOC_CLASSES 12
+#endif
+#define UNITY_MALLOC_CLASS_MAX ((size_t)UNITY_MALLOC_CLASS_MIN << (UNITY_MALLOC_CLASSES - 1))
+#ifndef UNITY_MALLOC_POOL_DEPTH
+#define UNITY_MALLOC_POOL_DEPTH 64
+#endif
+
+// Most counters --perf-counters can select at once
+#ifndef UNITY_PERF_MAX_EVENTS
+#define UNITY_PERF_MAX_EVENTS 8
+#endif
+
+// A benchmark grows its iteration count until one timed batch takes UNITY_BENCH_MIN_TIME_NS,
+// then keeps UNITY_BENCH_REPETITIONS batches of that size as its samples
+#ifndef UNITY_BENCH_MIN_TIME_NS
+#define UNITY_BENCH_MIN_TIME_NS 10000000.0
+#endif
+#ifndef UNITY_BENCH_REPETITIONS
+#define UNITY_BENCH_REPETITIONS 5
+#endif
+#ifndef UNITY_BENCH_MAX_ITERATIONS
+#define UNITY_BENCH_MAX_ITERATIONS 1000000000ul
+#endif
+// Samples whose coefficient of variation exceeds UNITY_BENCH_MAX_CV (--max-cv, in percent) are
+// thrown away and taken again, up to UNITY_BENCH_MAX_RERUNS times, before the result is unreliable
+#ifndef UNITY_BENCH_MAX_CV
+#define UNITY_BENCH_MAX_CV 0.05
+#endif
+#ifndef UNITY_BENCH_MAX_RERUNS
+#define UNITY_BENCH_MAX_RERUNS 3
+#endif
+// Size of the buffers the memcpy and memset reference bandwidths are measured with, larger than
+// the last level cache so that they show what memory can do
+#ifndef UNITY_BENCH_REFERENCE_BYTES
+#define UNITY_BENCH_REFERENCE_BYTES (64ul << 20)
+#endif
+// Pairs of batches a TEST_BENCHMARK_COMPARE times, each pair runs both implementations in random order
+#ifndef UNITY_BENCH_COMPARE_PAIRS
+#define UNITY_BENCH_COMPARE_PAIRS 15
+#endif
+#define UNITY_BENCH_MAX_SAMPLES \
+    ((UNITY_BENCH_COMPARE_PAIRS > UNITY_BENCH_REPETITIONS) ? UNITY_BENCH_COMPARE_PAIRS : UNITY_BENCH_REPETITIONS)
+// Most sizes a TEST_BENCHMARK_RANGE measures, the rest of the range is skipped
+#ifndef UNITY_BENCH_MAX_POINTS
+#define UNITY_BENCH_MAX_POINTS 32
+#endif
+
+// Storage class of per-thread state, like the debug allocator counters of a parallel run
+#ifndef UNITY_THREAD_LOCAL
+#if defined(__STDC_VERSION__) && (__STDC_VERSION__ >= 201112L) && !defined(__STDC_NO_THREADS__)
+#define UNITY_THREAD_LOCAL _Thread_local
+#elif defined(__GNUC__)
+#define UNITY_THREAD_LOCAL __thread
+#elif defined(_MSC_VER)
+#define UNITY_THREAD_LOCAL __declspec(thread)
+#else
+#define UNITY_THREAD_LOCAL
+#endif
+#endif
+
+/* DX_PATCH: with UNITY_WRAP_MALLOC the test program is linked with
+   -Wl,--wrap=malloc,--wrap=calloc,--wrap=realloc,--wrap=free, which routes every allocation
+   of the linked objects, third party libraries included, into the debug allocator without
+   the malloc macros. The framework takes its own buffers from the real allocator, so they
+   are never counted against a test. */
+#if defined(UNITY_WRAP_MALLOC)
+#ifndef UNITY_DYNAMIC_MEM_DEBUG
+#define UNITY_DYNAMIC_MEM_DEBUG
+#endif
+#include <stddef.h>
+void * __real_malloc(size_t size);
+void * __real_calloc(size_t num, size_t size);
+void * __real_realloc(void * mem, size_t size);
+void __real_free(void * mem);
+#define UNITY_INTERNAL_MALLOC   __real_malloc
+#define UNITY_INTERNAL_CALLOC   __real_calloc
+#define UNITY_INTERNAL_REALLOC  __real_realloc
+#define UNITY_INTERNAL_FREE     __real_free
+#else
+#define UNITY_INTERNAL_MALLOC   malloc
+#define UNITY_INTERNAL_CALLOC   calloc
+#define UNITY_INTERNAL_REALLOC  realloc
+#define UNITY_INTERNAL_FREE     free
+#endif
+
 //-------------------------------------------------------
 // Internal Structs Needed
 //-------------------------------------------------------
@@ -311,6 +446,68 @@ typedef enum
 } UNITY_DISPLAY_STYLE_T;
 
 
+/* DX_PATCH: result counters of one worker of a parallel run. Each worker owns one slot,
+   padded to a full cache line, and the slots are only summed up by UnityEnd. */
+struct _UnityResultSlot
+{
+    UNITY_COUNTER_TYPE NumberOfTests;
+    UNITY_COUNTER_TYPE TestFailures;
+    UNITY_COUNTER_TYPE TestIgnores;
+    char Padding[UNITY_CACHE_LINE_SIZE - 3 * sizeof(UNITY_COUNTER_TYPE)];
+};
+
+/* DX_PATCH: growable buffer holding the output of one test of a parallel run, so that it can be
+   written out in one piece */
+struct _UnityOutputBuffer
+{
+    char * Data;
+    unsigned long Length;
+    unsigned long Capacity;
+    struct _UnityOutputBuffer * Next;
+};
+
+/* DX_PATCH: allocations of the running test, kept by the fixture's debug allocator
+   (UNITY_DYNAMIC_MEM_DEBUG). Allocations counts every block handed out, including the new
+   block of a moving realloc, Reallocs counts the realloc calls. */
+typedef struct _UnityAllocationStats
+{
+    unsigned long Allocations;
+    unsigned long Reallocs;
+    size_t Bytes;
+    size_t PeakBytes;
+} UnityAllocationStats;
+
+struct _UnityMallocState
+{
+    int Count;
+    int FailCountdown;
+    long Attempts;
+    long FailIndex;
+    const char * FailFile;
+    int FailLine;
+    _UU32 FailThreshold;
+    _UU32 Random;
+    unsigned int TestId;
+    size_t LiveBytes;
+    UnityAllocationStats Stats;
+    void * FreeLists[UNITY_MALLOC_CLASSES];
+    unsigned short FreeCounts[UNITY_MALLOC_CLASSES];
+};
+
+#if defined(UNITY_PERF_COUNTERS)
+/* DX_PATCH: counters selected with --perf-counters, and their values for the last test body.
+   Name is the event actually counted, which differs when a software fallback was used. */
+struct _UnityPerfCounters
+{
+    unsigned int EventCount;
+    unsigned char Events[UNITY_PERF_MAX_EVENTS];
+    int Fd[UNITY_PERF_MAX_EVENTS];
+    const char * Name[UNITY_PERF_MAX_EVENTS];
+    unsigned long long Value[UNITY_PERF_MAX_EVENTS];
+    int Valid[UNITY_PERF_MAX_EVENTS];
+};
+#endif
+
 /* DX_PATCH: jumpless version. "jmp_buf AbortFrame" removed from struct _Unity*/
 struct _Unity
 {
@@ -323,12 +520,39 @@ struct _Unity
     UNITY_COUNTER_TYPE CurrentTestFailed;
     UNITY_COUNTER_TYPE CurrentTestIgnored;
     void * testLocalStorage;
+    int OutputMuted;
+    int ReportAllMismatches;    // array asserts count every mismatch instead of stopping at the first
+    int RecordDigests;          // digest asserts print the digest and pass
+    long MallocFailIndex;       // allocation failed by an allocation sweep run, -1 for none
+    unsigned char * RestoreStack;   // values saved by UT_PTR_SET / UT_VALUE_SET, undone after the test
+    size_t RestoreLength;
+    size_t RestoreCapacity;
+    struct _UnityMallocState Malloc;
+#if defined(UNITY_PERF_COUNTERS)
+    struct _UnityPerfCounters Perf;
+#endif
+    struct _UnityOutputBuffer * Capture;
+    struct _UnityResultSlot * ResultSlots;
+    unsigned int ResultSlotCount;
 
     // only used by the fixture - should not be changed per test
     int Verbose;
     unsigned int RepeatCount;
+    unsigned long RepeatTestCount;
+    int UntilFail;
     const char* NameFilter;
     const char* GroupFilter;
+    unsigned int Jobs;
+    int OrderedOutput;
+    int UpdateGolden;
+    int AllocSweep;
+    const char* BenchmarkOut;
+    int PinCpu;                 // -1 when the run is not pinned
+    double BenchMaxCv;          // samples of a benchmark varying more than this are taken again
+    int BenchCacheMode;         // --cache-mode of benchmarks that do not choose their own
+    unsigned int BenchRotateCopies;
+    struct _UnityBenchOutput * BenchOutput;
+    struct _UnityParallel * Parallel;
 };
 
 //extern struct _Unity Unity;
@@ -346,6 +570,7 @@ void UnityDefaultTestRun(UnityTestFunction Func, const char* FuncName, const int
 // Test Output
 //-------------------------------------------------------
 
+void UnityPrintChar(const char ch, struct _Unity * const unity_p);
 void UnityPrint(const char* string, struct _Unity * const unity_p);
 void UnityPrintMask(const _U_UINT mask, const _U_UINT number, struct _Unity * const unity_p);
 void UnityPrintNumberByStyle(const _U_SINT number, const UNITY_DISPLAY_STYLE_T style, struct _Unity * const unity_p);
@@ -403,6 +628,38 @@ bool UnityAssertEqualMemory( UNITY_PTR_ATTRIBUTE const void* expected,
                              const char* msg,
                              const UNITY_LINE_TYPE lineNumber, const char *file, struct _Unity * const unity_p);
 
+#ifdef UNITY_SUPPORT_64
+_UU64 UnityDigest(UNITY_PTR_ATTRIBUTE const void* data, const _UU32 length);
+
+bool UnityAssertDigestEqual(const _UU64 expected,
+                            UNITY_PTR_ATTRIBUTE const void* actual,
+                            const _UU32 length,
+                            const char* msg,
+                            const UNITY_LINE_TYPE lineNumber, const char *file, struct _Unity * const unity_p);
+#endif
+
+/// state of a streaming compare, see UnityStreamCompareFeed
+typedef struct _UnityStreamCompare
+{
+    _U_UINT Offset;     // bytes found equal so far
+} UnityStreamCompare;
+
+void UnityStreamCompareBegin(UnityStreamCompare* const stream);
+
+bool UnityStreamCompareFeed(UnityStreamCompare* const stream,
+                            UNITY_PTR_ATTRIBUTE const unsigned char** expected,
+                            _UU32* const expected_len,
+                            UNITY_PTR_ATTRIBUTE const unsigned char** actual,
+                            _UU32* const actual_len,
+                            const char* msg,
+                            const UNITY_LINE_TYPE lineNumber, const char *file, struct _Unity * const unity_p);
+
+bool UnityStreamCompareEnd(UnityStreamCompare* const stream,
+                           const _UU32 expected_left,
+                           const _UU32 actual_left,
+                           const char* msg,
+                           const UNITY_LINE_TYPE lineNumber, const char *file, struct _Unity * const unity_p);
+
 bool UnityAssertNumbersWithin(const _U_SINT delta,
                               const _U_SINT expected,
                               const _U_SINT actual,
@@ -438,6 +695,19 @@ bool UnityAssertFloatIsNegInf(const _UF actual,
 bool UnityAssertFloatIsNaN(const _UF actual,
                            const char* msg,
                            const UNITY_LINE_TYPE lineNumber, const char *file, struct _Unity * const unity_p);
+
+bool UnityAssertFloatUlps(const _UU32 ulps,
+                          const _UF expected,
+                          const _UF actual,
+                          const char* msg,
+                          const UNITY_LINE_TYPE lineNumber, const char *file, struct _Unity * const unity_p);
+
+bool UnityAssertFloatArrayUlps(const _UU32 ulps,
+                               UNITY_PTR_ATTRIBUTE const _UF* expected,
+                               UNITY_PTR_ATTRIBUTE const _UF* actual,
+                               const _UU32 num_elements,
+                               const char* msg,
+                               const UNITY_LINE_TYPE lineNumber, const char *file, struct _Unity * const unity_p);
 #endif
 
 #ifndef UNITY_EXCLUDE_DOUBLE
@@ -464,6 +734,21 @@ bool UnityAssertDoubleIsNegInf(const _UD actual,
 bool UnityAssertDoubleIsNaN(const _UD actual,
                             const char* msg,
                             const UNITY_LINE_TYPE lineNumber, struct _Unity * const unity_p);
+
+#ifdef UNITY_SUPPORT_64
+bool UnityAssertDoubleUlps(const _UU64 ulps,
+                           const _UD expected,
+                           const _UD actual,
+                           const char* msg,
+                           const UNITY_LINE_TYPE lineNumber, const char *file, struct _Unity * const unity_p);
+
+bool UnityAssertDoubleArrayUlps(const _UU64 ulps,
+                                UNITY_PTR_ATTRIBUTE const _UD* expected,
+                                UNITY_PTR_ATTRIBUTE const _UD* actual,
+                                const _UU32 num_elements,
+                                const char* msg,
+                                const UNITY_LINE_TYPE lineNumber, const char *file, struct _Unity * const unity_p);
+#endif
 #endif
 
 //-------------------------------------------------------
@@ -509,6 +794,8 @@ bool UnityAssertDoubleIsNaN(const _UD actual,
 #define UNITY_TEST_ASSERT_EQUAL_PTR(expected, actual, line, message)                             if (UnityAssertEqualNumber((_U_SINT)(_UP)(expected), (_U_SINT)(_UP)(actual), (message), (UNITY_LINE_TYPE)line, __FILE__, UNITY_DISPLAY_STYLE_POINTER, unity_p) != 0) return;
 #define UNITY_TEST_ASSERT_EQUAL_STRING(expected, actual, line, message)                          if (UnityAssertEqualString((const char*)(expected), (const char*)(actual), (message), (UNITY_LINE_TYPE)line, __FILE__, unity_p) != 0) return;
 #define UNITY_TEST_ASSERT_EQUAL_MEMORY(expected, actual, len, line, message)                     if (UnityAssertEqualMemory((UNITY_PTR_ATTRIBUTE void*)(expected), (UNITY_PTR_ATTRIBUTE void*)(actual), (_UU32)(len), 1, (message), (UNITY_LINE_TYPE)line, __FILE__, unity_p) != 0) return;
+#define UNITY_TEST_ASSERT_STREAM_FEED(stream, expected, expected_len, actual, actual_len, line, message) if (UnityStreamCompareFeed((stream), &(expected), &(expected_len), &(actual), &(actual_len), (message), (UNITY_LINE_TYPE)line, __FILE__, unity_p) != 0) return;
+#define UNITY_TEST_ASSERT_STREAM_END(stream, expected_left, actual_left, line, message)          if (UnityStreamCompareEnd((stream), (_UU32)(expected_left), (_UU32)(actual_left), (message), (UNITY_LINE_TYPE)line, __FILE__, unity_p) != 0) return;
 
 #define UNITY_TEST_ASSERT_EQUAL_INT_ARRAY(expected, actual, num_elements, line, message)         if (UnityAssertEqualIntArray((UNITY_PTR_ATTRIBUTE const void*)(expected), (UNITY_PTR_ATTRIBUTE const void*)(actual), (_UU32)(num_elements), (message), (UNITY_LINE_TYPE)line, __FILE__, UNITY_DISPLAY_STYLE_INT, unity_p) != 0) return;
 #define UNITY_TEST_ASSERT_EQUAL_INT8_ARRAY(expected, actual, num_elements, line, message)        if (UnityAssertEqualIntArray((UNITY_PTR_ATTRIBUTE const void*)(expected), (UNITY_PTR_ATTRIBUTE const void*)(actual), (_UU32)(num_elements), (message), (UNITY_LINE_TYPE)line, __FILE__, UNITY_DISPLAY_STYLE_INT8, unity_p) != 0) return;
@@ -523,7 +810,7 @@ bool UnityAssertDoubleIsNaN(const _UD actual,
 #define UNITY_TEST_ASSERT_EQUAL_HEX32_ARRAY(expected, actual, num_elements, line, message)       if (UnityAssertEqualIntArray((UNITY_PTR_ATTRIBUTE const void*)(expected), (UNITY_PTR_ATTRIBUTE const void*)(actual), (_UU32)(num_elements), (message), (UNITY_LINE_TYPE)line, __FILE__, UNITY_DISPLAY_STYLE_HEX32, unity_p) != 0) return;
 #define UNITY_TEST_ASSERT_EQUAL_PTR_ARRAY(expected, actual, num_elements, line, message)         if (UnityAssertEqualIntArray((UNITY_PTR_ATTRIBUTE const void*)(_UP*)(expected), (const void*)(_UP*)(actual), (_UU32)(num_elements), (message), (UNITY_LINE_TYPE)line, __FILE__, UNITY_DISPLAY_STYLE_POINTER, unity_p) != 0) return;
 #define UNITY_TEST_ASSERT_EQUAL_STRING_ARRAY(expected, actual, num_elements, line, message)      if (UnityAssertEqualStringArray((const char**)(expected), (const char**)(actual), (_UU32)(num_elements), (message), (UNITY_LINE_TYPE)line, __FILE__, unity_p) != 0) return;
-#define UNITY_TEST_ASSERT_EQUAL_MEMORY_ARRAY(expected, actual, len, num_elements, line, message) if (UnityAssertEqualMemory((UNITY_PTR_ATTRIBUTE void*)(expected), (UNITY_PTR_ATTRIBUTE void*)(actual), (_UU32)(len), (_UU32)(num_elements), (message), (UNITY_LINE_TYPE)line, __FILE__) != 0) return;
+#define UNITY_TEST_ASSERT_EQUAL_MEMORY_ARRAY(expected, actual, len, num_elements, line, message) if (UnityAssertEqualMemory((UNITY_PTR_ATTRIBUTE void*)(expected), (UNITY_PTR_ATTRIBUTE void*)(actual), (_UU32)(len), (_UU32)(num_elements), (message), (UNITY_LINE_TYPE)line, __FILE__, unity_p) != 0) return;
 
 #ifdef UNITY_SUPPORT_64
 #define UNITY_TEST_ASSERT_EQUAL_INT64(expected, actual, line, message)                           if (UnityAssertEqualNumber((_U_SINT)(expected), (_U_SINT)(actual), (message), (UNITY_LINE_TYPE)line, __FILE__, UNITY_DISPLAY_STYLE_INT64, unity_p) != 0) return;
@@ -532,6 +819,7 @@ bool UnityAssertDoubleIsNaN(const _UD actual,
 #define UNITY_TEST_ASSERT_EQUAL_INT64_ARRAY(expected, actual, num_elements, line, message)       if (UnityAssertEqualIntArray((UNITY_PTR_ATTRIBUTE const _U_SINT*)(expected), (UNITY_PTR_ATTRIBUTE const _U_SINT*)(actual), (_UU32)(num_elements), (message), (UNITY_LINE_TYPE)line, __FILE__, UNITY_DISPLAY_STYLE_INT64, unity_p) != 0) return;
 #define UNITY_TEST_ASSERT_EQUAL_UINT64_ARRAY(expected, actual, num_elements, line, message)      if (UnityAssertEqualIntArray((UNITY_PTR_ATTRIBUTE const _U_SINT*)(expected), (UNITY_PTR_ATTRIBUTE const _U_SINT*)(actual), (_UU32)(num_elements), (message), (UNITY_LINE_TYPE)line, __FILE__, UNITY_DISPLAY_STYLE_UINT64, unity_p) != 0) return;
 #define UNITY_TEST_ASSERT_EQUAL_HEX64_ARRAY(expected, actual, num_elements, line, message)       if (UnityAssertEqualIntArray((UNITY_PTR_ATTRIBUTE const _U_SINT*)(expected), (UNITY_PTR_ATTRIBUTE const _U_SINT*)(actual), (_UU32)(num_elements), (message), (UNITY_LINE_TYPE)line, __FILE__, UNITY_DISPLAY_STYLE_HEX64, unity_p) != 0) return;
+#define UNITY_TEST_ASSERT_DIGEST_EQUAL(expected_digest, actual, len, line, message)              if (UnityAssertDigestEqual((_UU64)(expected_digest), (UNITY_PTR_ATTRIBUTE const void*)(actual), (_UU32)(len), (message), (UNITY_LINE_TYPE)line, __FILE__, unity_p) != 0) return;
 #define UNITY_TEST_ASSERT_HEX64_WITHIN(delta, expected, actual, line, message)                   if (UnityAssertNumbersWithin((_U_SINT)(delta), (_U_SINT)(expected), (_U_SINT)(actual), NULL, (UNITY_LINE_TYPE)line, __FILE__, UNITY_DISPLAY_STYLE_HEX64) != 0, unity_p) return;
 #endif
 
@@ -542,6 +830,8 @@ bool UnityAssertDoubleIsNaN(const _UD actual,
 #define UNITY_TEST_ASSERT_FLOAT_IS_INF(actual, line, message)                                    UNITY_TEST_FAIL((UNITY_LINE_TYPE)line, "Unity Floating Point Disabled", unity_p)
 #define UNITY_TEST_ASSERT_FLOAT_IS_NEG_INF(actual, line, message)                                UNITY_TEST_FAIL((UNITY_LINE_TYPE)line, "Unity Floating Point Disabled", unity_p)
 #define UNITY_TEST_ASSERT_FLOAT_IS_NAN(actual, line, message)                                    UNITY_TEST_FAIL((UNITY_LINE_TYPE)line, "Unity Floating Point Disabled", unity_p)
+#define UNITY_TEST_ASSERT_FLOAT_ULPS(ulps, expected, actual, line, message)                      UNITY_TEST_FAIL((UNITY_LINE_TYPE)line, "Unity Floating Point Disabled", unity_p)
+#define UNITY_TEST_ASSERT_FLOAT_ARRAY_ULPS(ulps, expected, actual, num_elements, line, message)  UNITY_TEST_FAIL((UNITY_LINE_TYPE)line, "Unity Floating Point Disabled", unity_p)
 #else
 #define UNITY_TEST_ASSERT_FLOAT_WITHIN(delta, expected, actual, line, message)                   if (UnityAssertFloatsWithin((_UF)(delta), (_UF)(expected), (_UF)(actual), (message), (UNITY_LINE_TYPE)line, __FILE__, unity_p) != 0) return;
 #define UNITY_TEST_ASSERT_EQUAL_FLOAT(expected, actual, line, message)                           UNITY_TEST_ASSERT_FLOAT_WITHIN((_UF)(expected) * (_UF)UNITY_FLOAT_PRECISION, (_UF)expected, (_UF)actual, (UNITY_LINE_TYPE)line, __FILE__, message, unity_p)
@@ -549,6 +839,8 @@ bool UnityAssertDoubleIsNaN(const _UD actual,
 #define UNITY_TEST_ASSERT_FLOAT_IS_INF(actual, line, message)                                    if (UnityAssertFloatIsInf((_UF)(actual), (message), (UNITY_LINE_TYPE)line, __FILE__, unity_p) != 0) return;
 #define UNITY_TEST_ASSERT_FLOAT_IS_NEG_INF(actual, line, message)                                if (UnityAssertFloatIsNegInf((_UF)(actual), (message), (UNITY_LINE_TYPE)line, __FILE__, unity_p) != 0) return;
 #define UNITY_TEST_ASSERT_FLOAT_IS_NAN(actual, line, message)                                    if (UnityAssertFloatIsNaN((_UF)(actual), (message), (UNITY_LINE_TYPE)line, __FILE__, unity_p) != 0) return;
+#define UNITY_TEST_ASSERT_FLOAT_ULPS(ulps, expected, actual, line, message)                      if (UnityAssertFloatUlps((_UU32)(ulps), (_UF)(expected), (_UF)(actual), (message), (UNITY_LINE_TYPE)line, __FILE__, unity_p) != 0) return;
+#define UNITY_TEST_ASSERT_FLOAT_ARRAY_ULPS(ulps, expected, actual, num_elements, line, message)  if (UnityAssertFloatArrayUlps((_UU32)(ulps), (_UF*)(expected), (_UF*)(actual), (_UU32)(num_elements), (message), (UNITY_LINE_TYPE)line, __FILE__, unity_p) != 0) return;
 #endif
 
 #ifdef UNITY_EXCLUDE_DOUBLE
@@ -558,6 +850,8 @@ bool UnityAssertDoubleIsNaN(const _UD actual,
 #define UNITY_TEST_ASSERT_DOUBLE_IS_INF(actual, line, message)                                   UNITY_TEST_FAIL((UNITY_LINE_TYPE)line, "Unity Double Precision Disabled", unity_p)
 #define UNITY_TEST_ASSERT_DOUBLE_IS_NEG_INF(actual, line, message)                               UNITY_TEST_FAIL((UNITY_LINE_TYPE)line, "Unity Double Precision Disabled", unity_p)
 #define UNITY_TEST_ASSERT_DOUBLE_IS_NAN(actual, line, message)                                   UNITY_TEST_FAIL((UNITY_LINE_TYPE)line, "Unity Double Precision Disabled", unity_p)
+#define UNITY_TEST_ASSERT_DOUBLE_ULPS(ulps, expected, actual, line, message)                     UNITY_TEST_FAIL((UNITY_LINE_TYPE)line, "Unity Double Precision Disabled", unity_p)
+#define UNITY_TEST_ASSERT_DOUBLE_ARRAY_ULPS(ulps, expected, actual, num_elements, line, message) UNITY_TEST_FAIL((UNITY_LINE_TYPE)line, "Unity Double Precision Disabled", unity_p)
 #else
 #define UNITY_TEST_ASSERT_DOUBLE_WITHIN(delta, expected, actual, line, message)                  if (UnityAssertDoublesWithin((_UD)(delta), (_UD)(expected), (_UD)(actual), (message), (UNITY_LINE_TYPE)line, __FILE__, unity_p) != 0) return;
 #define UNITY_TEST_ASSERT_EQUAL_DOUBLE(expected, actual, line, message)                          UNITY_TEST_ASSERT_DOUBLE_WITHIN((_UD)(expected) * (_UD)UNITY_DOUBLE_PRECISION, (_UD)expected, (_UD)actual, (UNITY_LINE_TYPE)line, __FILE__, message, unity_p)
@@ -565,6 +859,8 @@ bool UnityAssertDoubleIsNaN(const _UD actual,
 #define UNITY_TEST_ASSERT_DOUBLE_IS_INF(actual, line, message)                                   if (UnityAssertDoubleIsInf((_UD)(actual), (message), (UNITY_LINE_TYPE)line, __FILE__, unity_p) != 0) return;
 #define UNITY_TEST_ASSERT_DOUBLE_IS_NEG_INF(actual, line, message)                               if (UnityAssertDoubleIsNegInf((_UD)(actual), (message), (UNITY_LINE_TYPE)line, __FILE__, unity_p) != 0) return;
 #define UNITY_TEST_ASSERT_DOUBLE_IS_NAN(actual, line, message)                                   if (UnityAssertDoubleIsNaN((_UD)(actual), (message), (UNITY_LINE_TYPE)line, __FILE__, unity_p) != 0) return;
+#define UNITY_TEST_ASSERT_DOUBLE_ULPS(ulps, expected, actual, line, message)                     if (UnityAssertDoubleUlps((_UU64)(ulps), (_UD)(expected), (_UD)(actual), (message), (UNITY_LINE_TYPE)line, __FILE__, unity_p) != 0) return;
+#define UNITY_TEST_ASSERT_DOUBLE_ARRAY_ULPS(ulps, expected, actual, num_elements, line, message) if (UnityAssertDoubleArrayUlps((_UU64)(ulps), (_UD*)(expected), (_UD*)(actual), (_UU32)(num_elements), (message), (UNITY_LINE_TYPE)line, __FILE__, unity_p) != 0) return;
 #endif
 
 #endif